@@ -0,0 +1,27 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/test/CircularVectorTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/CircularVectorTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/CircularVectorTests.cpp.o.d"
+  "/root/repo/test/InstrumentationTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/InstrumentationTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/InstrumentationTests.cpp.o.d"
+  "/root/repo/test/IntrusiveLinkedListTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/IntrusiveLinkedListTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/IntrusiveLinkedListTests.cpp.o.d"
+  "/root/repo/test/LinkedListTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/LinkedListTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/LinkedListTests.cpp.o.d"
+  "/root/repo/test/LockFreeQueueTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/LockFreeQueueTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/LockFreeQueueTests.cpp.o.d"
+  "/root/repo/test/SmallVectorTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/SmallVectorTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/SmallVectorTests.cpp.o.d"
+  "/root/repo/test/UnrolledLinkedListTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/UnrolledLinkedListTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/UnrolledLinkedListTests.cpp.o.d"
+  "/root/repo/test/VectorTests.cpp" "CMakeFiles/aisdiLinearTests.dir/test/VectorTests.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/VectorTests.cpp.o.d"
+  "/root/repo/test/test_main.cpp" "CMakeFiles/aisdiLinearTests.dir/test/test_main.cpp.o" "gcc" "CMakeFiles/aisdiLinearTests.dir/test/test_main.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,27 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/aisdiLinearTests.dir/test/CircularVectorTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/CircularVectorTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/InstrumentationTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/InstrumentationTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/IntrusiveLinkedListTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/IntrusiveLinkedListTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/LinkedListTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/LinkedListTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/LockFreeQueueTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/LockFreeQueueTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/SmallVectorTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/SmallVectorTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/UnrolledLinkedListTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/UnrolledLinkedListTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/VectorTests.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/VectorTests.cpp.o.d"
+  "CMakeFiles/aisdiLinearTests.dir/test/test_main.cpp.o"
+  "CMakeFiles/aisdiLinearTests.dir/test/test_main.cpp.o.d"
+  "bin/aisdiLinearTests"
+  "bin/aisdiLinearTests.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/aisdiLinearTests.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
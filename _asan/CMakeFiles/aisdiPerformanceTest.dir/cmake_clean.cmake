@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/aisdiPerformanceTest.dir/src/main.cpp.o"
+  "CMakeFiles/aisdiPerformanceTest.dir/src/main.cpp.o.d"
+  "bin/aisdiPerformanceTest"
+  "bin/aisdiPerformanceTest.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/aisdiPerformanceTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
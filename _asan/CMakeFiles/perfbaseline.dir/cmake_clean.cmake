@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/perfbaseline"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/perfbaseline.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
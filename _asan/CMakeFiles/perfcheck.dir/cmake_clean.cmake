@@ -0,0 +1,8 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/perfcheck"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/perfcheck.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo
+# Build directory: /root/repo/_asan
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(boostUnitTestsRun "/root/repo/_asan/bin/aisdiLinearTests")
+set_tests_properties(boostUnitTestsRun PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/CMakeLists.txt;31;add_test;/root/repo/CMakeLists.txt;0;")
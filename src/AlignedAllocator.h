@@ -0,0 +1,104 @@
+#ifndef AISDI_LINEAR_ALIGNEDALLOCATOR_H
+#define AISDI_LINEAR_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "Vector.hpp"
+
+namespace aisdi
+{
+
+/**
+ * @brief allocator returning memory aligned to 'Alignment' bytes, e.g. 64
+ *        for a cache line or a full AVX-512 register.
+ *
+ *        With 'HugePages' set, buffers of at least hugePageSize bytes are
+ *        aligned and padded to whole huge pages, and on Linux marked with
+ *        madvise(MADV_HUGEPAGE) so that transparent huge pages back them.
+ *        Elsewhere the hint is skipped and only the alignment remains.
+ */
+template <typename Type, std::size_t Alignment = 64, bool HugePages = false>
+class AlignedAllocator
+{
+  static_assert(Alignment != 0 && (Alignment & (Alignment - 1)) == 0,
+                "Alignment has to be a power of two");
+  static_assert(Alignment >= alignof(Type), "Alignment cannot be weaker than the one of the type");
+
+public:
+  using value_type = Type;
+
+  static constexpr std::size_t hugePageSize = std::size_t(2) << 20;
+
+  template <typename Other>
+  struct rebind
+  {
+    using other = AlignedAllocator<Other, Alignment, HugePages>;
+  };
+
+  AlignedAllocator() = default;
+  template <typename Other>
+  AlignedAllocator(const AlignedAllocator<Other, Alignment, HugePages> &) {}
+
+  Type *allocate(std::size_t count)
+  {
+    if (count > std::size_t(-1) / sizeof(Type))
+      throw std::bad_array_new_length();
+
+    std::size_t bytes = count * sizeof(Type);
+    if (!usesHugePages(bytes))
+      return static_cast<Type *>(::operator new(bytes, std::align_val_t(Alignment)));
+
+    bytes = roundToHugePages(bytes);
+    void *memory = ::operator new(bytes, std::align_val_t(hugePageSize));
+#ifdef __linux__
+    // only a hint, the kernel may still back the buffer with 4K pages
+    madvise(memory, bytes, MADV_HUGEPAGE);
+#endif
+    return static_cast<Type *>(memory);
+  }
+
+  void deallocate(Type *memory, std::size_t count)
+  {
+    if (usesHugePages(count * sizeof(Type)))
+      ::operator delete(memory, std::align_val_t(hugePageSize));
+    else
+      ::operator delete(memory, std::align_val_t(Alignment));
+  }
+
+  template <typename Other>
+  bool operator==(const AlignedAllocator<Other, Alignment, HugePages> &) const { return true; }
+  template <typename Other>
+  bool operator!=(const AlignedAllocator<Other, Alignment, HugePages> &) const { return false; }
+
+private:
+  static bool usesHugePages(std::size_t bytes)
+  {
+    return HugePages && bytes >= hugePageSize;
+  }
+  static std::size_t roundToHugePages(std::size_t bytes)
+  {
+    return (bytes + hugePageSize - 1) / hugePageSize * hugePageSize;
+  }
+};
+
+/**
+ * @brief Vector whose buffer starts at an 'Alignment' byte boundary
+ */
+template <typename Type, std::size_t Alignment = 64, typename Policy = DefaultGrowthPolicy>
+using AlignedVector = Vector<Type, Policy, AlignedAllocator<Type, Alignment>>;
+
+/**
+ * @brief Vector backed by transparent huge pages once its buffer reaches
+ *        hugePageSize bytes, for large arrays scanned over and over
+ */
+template <typename Type, typename Policy = DefaultGrowthPolicy>
+using HugePageVector = Vector<Type, Policy, AlignedAllocator<Type, 64, true>>;
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_ALIGNEDALLOCATOR_H
@@ -0,0 +1,109 @@
+#ifndef AISDI_LINEAR_BACKGROUNDRECLAIMER_H
+#define AISDI_LINEAR_BACKGROUNDRECLAIMER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace aisdi
+{
+
+/**
+ * @brief a thread that runs deferred clean-up tasks, such as destroying the
+ *        elements and freeing the memory of containers passed to it by their
+ *        releaseAsync(). Handing a task over takes a lock and no waiting
+ *        for the work itself.
+ *
+ *        Started on first use, one per process. At exit it finishes every
+ *        pending task before the program ends.
+ */
+class BackgroundReclaimer
+{
+public:
+  static BackgroundReclaimer &instance()
+  {
+    static BackgroundReclaimer reclaimer;
+    return reclaimer;
+  }
+
+  BackgroundReclaimer(const BackgroundReclaimer &) = delete;
+  BackgroundReclaimer &operator=(const BackgroundReclaimer &) = delete;
+
+  /**
+   * @brief runs 'task' on the reclaimer thread, tasks must not throw
+   */
+  void defer(std::function<void()> task)
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _tasks.push_back(std::move(task));
+      ++_pending;
+    }
+    _wake.notify_one();
+  }
+
+  /**
+   * @brief waits until every task deferred before the call has run
+   */
+  void drain()
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] { return _pending == 0; });
+  }
+
+private:
+  std::mutex _mutex;
+  std::condition_variable _wake;
+  std::condition_variable _idle;
+  std::vector<std::function<void()>> _tasks;
+  std::size_t _pending = 0;
+  bool _stopping = false;
+  // declared last, the thread starts once everything above is set up
+  std::thread _worker;
+
+  BackgroundReclaimer() : _worker([this] { run(); }) {}
+
+  ~BackgroundReclaimer()
+  {
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      _stopping = true;
+    }
+    _wake.notify_one();
+    _worker.join();
+  }
+
+  void run()
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true)
+    {
+      _wake.wait(lock, [this] { return _stopping || !_tasks.empty(); });
+      if (_tasks.empty())
+        return;
+
+      // tasks run in batches, without the lock, so that defer() never
+      // waits for clean-up work
+      std::vector<std::function<void()>> batch;
+      batch.swap(_tasks);
+      lock.unlock();
+      for (auto &task : batch)
+        task();
+      const auto done = batch.size();
+      batch.clear();
+      lock.lock();
+
+      _pending -= done;
+      if (_pending == 0)
+        _idle.notify_all();
+    }
+  }
+};
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_BACKGROUNDRECLAIMER_H
@@ -0,0 +1,308 @@
+#ifndef AISDI_LINEAR_BASELINE_H
+#define AISDI_LINEAR_BASELINE_H
+
+#include <cctype>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Benchmark.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+/**
+ * @brief results saved earlier with --save-baseline (or --json), which
+ *        fresh results are checked against.
+ *
+ *        A benchmark regressed when both its median and its minimum grew
+ *        by more than its tolerance, requiring both keeps one unlucky run
+ *        from failing the check, and by more than noiseNs, below which
+ *        differences of the shortest benchmarks are timer and scheduler
+ *        noise whatever their tolerance. The tolerance is the one given
+ *        with --tolerance on the checking run. Benchmarks registered with
+ *        a tolerance of their own save it with their results, a tolerance
+ *        there, also one added by hand, loosens or tightens that scenario
+ *        whatever --tolerance says.
+ */
+class Baseline
+{
+public:
+  static constexpr double noiseNs = 5000;
+
+  /**
+   * @brief reads the file at 'path', throws std::runtime_error if it
+   *        cannot be read or is not a results file
+   */
+  static Baseline load(const std::string &path)
+  {
+    std::ifstream file(path);
+    if (!file)
+      throw std::runtime_error("Cannot read baseline " + path +
+                               ", write one first with --save-baseline=" + path);
+
+    std::string text((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    Baseline baseline;
+    try
+    {
+      Parser(text).parseResults(baseline._entries);
+    }
+    catch (const std::runtime_error &e)
+    {
+      throw std::runtime_error("Malformed baseline " + path + ": " + e.what());
+    }
+    return baseline;
+  }
+
+  /**
+   * @brief prints how every result compares to the baseline
+   * @return false if any benchmark regressed
+   */
+  bool check(const std::vector<Result> &results, std::ostream &out = std::cout) const
+  {
+    auto flags = out.flags();
+    out << "\ncompared to the baseline\n"
+        << std::left << std::setw(48) << "benchmark" << std::right << std::setw(10) << "size" << std::setw(14)
+        << "baseline ms" << std::setw(12) << "now ms" << std::setw(10) << "change" << std::setw(11)
+        << "tolerance" << "  verdict\n";
+
+    std::size_t regressions = 0;
+    for (const auto &result : results)
+    {
+      const Entry *entry = find(result.name, result.size);
+      out << std::left << std::setw(48) << result.name << std::right << std::setw(10) << result.size
+          << std::fixed << std::setprecision(3);
+      if (!entry)
+      {
+        out << std::setw(14) << "-" << std::setw(12) << result.medianNs / 1e6 << "  new\n";
+        continue;
+      }
+
+      const double tolerance = entry->tolerance >= 0 ? entry->tolerance : result.tolerance;
+      const double limit = 1 + tolerance;
+      auto exceeds = [limit](double now, double before) { return now > before * limit && now - before > noiseNs; };
+      const char *verdict = "ok";
+      if (exceeds(result.medianNs, entry->medianNs) && exceeds(result.minNs, entry->minNs))
+      {
+        verdict = "REGRESSION";
+        ++regressions;
+      }
+      else if (exceeds(entry->medianNs, result.medianNs))
+        verdict = "faster";
+
+      const double change = entry->medianNs > 0 ? 100 * (result.medianNs / entry->medianNs - 1) : 0;
+      out << std::setw(14) << entry->medianNs / 1e6 << std::setw(12) << result.medianNs / 1e6
+          << std::setprecision(1) << std::setw(9) << std::showpos << change << std::noshowpos << "%"
+          << std::setw(10) << 100 * tolerance << "%  " << verdict << "\n";
+    }
+
+    out << regressions << (regressions == 1 ? " regression\n" : " regressions\n");
+    out.flags(flags);
+    return regressions == 0;
+  }
+
+private:
+  struct Entry
+  {
+    std::string name;
+    std::size_t size = 0;
+    double medianNs = 0;
+    double minNs = 0;
+    // negative when not saved
+    double tolerance = -1;
+  };
+
+  std::vector<Entry> _entries;
+
+  const Entry *find(const std::string &name, std::size_t size) const
+  {
+    for (const auto &entry : _entries)
+      if (entry.size == size && entry.name == name)
+        return &entry;
+    return nullptr;
+  }
+
+  /**
+   * @brief reads the JSON written by Runner::writeJson(). Any valid JSON is
+   *        accepted, members other than those of the results are skipped.
+   */
+  class Parser
+  {
+  public:
+    explicit Parser(const std::string &text) : _text(text), _at(0) {}
+
+    void parseResults(std::vector<Entry> &entries)
+    {
+      bool found = false;
+      parseObject([&](const std::string &key) {
+        if (key != "benchmarks")
+          return skipValue();
+        found = true;
+        parseArray([&] { entries.push_back(parseEntry()); });
+      });
+      if (!found)
+        throw std::runtime_error("no \"benchmarks\" array");
+    }
+
+  private:
+    const std::string &_text;
+    std::size_t _at;
+
+    Entry parseEntry()
+    {
+      Entry entry;
+      bool named = false, timed = false;
+      parseObject([&](const std::string &key) {
+        if (key == "name")
+        {
+          entry.name = parseString();
+          named = true;
+        }
+        else if (key == "size")
+          entry.size = static_cast<std::size_t>(parseNumber());
+        else if (key == "median_ns")
+        {
+          entry.medianNs = parseNumber();
+          timed = true;
+        }
+        else if (key == "min_ns")
+          entry.minNs = parseNumber();
+        else if (key == "tolerance")
+          entry.tolerance = parseNumber();
+        else
+          skipValue();
+      });
+      if (!named || !timed)
+        throw std::runtime_error("result without \"name\" or \"median_ns\"");
+      return entry;
+    }
+
+    template <typename Member>
+    void parseObject(Member member)
+    {
+      expect('{');
+      if (consume('}'))
+        return;
+      do
+      {
+        std::string key = parseString();
+        expect(':');
+        member(key);
+      } while (consume(','));
+      expect('}');
+    }
+
+    template <typename Item>
+    void parseArray(Item item)
+    {
+      expect('[');
+      if (consume(']'))
+        return;
+      do
+        item();
+      while (consume(','));
+      expect(']');
+    }
+
+    std::string parseString()
+    {
+      expect('"');
+      std::string value;
+      while (_at < _text.size() && _text[_at] != '"')
+      {
+        char c = _text[_at++];
+        if (c == '\\' && _at < _text.size())
+        {
+          c = _text[_at++];
+          // \uXXXX is kept as is, names never need it
+          if (c == 'n')
+            c = '\n';
+          else if (c == 't')
+            c = '\t';
+        }
+        value += c;
+      }
+      expect('"');
+      return value;
+    }
+
+    double parseNumber()
+    {
+      skipSpace();
+      const char *begin = _text.c_str() + _at;
+      char *end = nullptr;
+      double value = std::strtod(begin, &end);
+      if (end == begin)
+        fail("number");
+      _at += static_cast<std::size_t>(end - begin);
+      return value;
+    }
+
+    void skipValue()
+    {
+      skipSpace();
+      if (_at >= _text.size())
+        fail("value");
+
+      char c = _text[_at];
+      if (c == '{')
+        parseObject([this](const std::string &) { skipValue(); });
+      else if (c == '[')
+        parseArray([this] { skipValue(); });
+      else if (c == '"')
+        parseString();
+      else if (std::isalpha(static_cast<unsigned char>(c)))
+      {
+        while (_at < _text.size() && std::isalpha(static_cast<unsigned char>(_text[_at])))
+          ++_at;
+      }
+      else
+        parseNumber();
+    }
+
+    void skipSpace()
+    {
+      while (_at < _text.size() && std::isspace(static_cast<unsigned char>(_text[_at])))
+        ++_at;
+    }
+
+    bool consume(char c)
+    {
+      skipSpace();
+      if (_at < _text.size() && _text[_at] == c)
+      {
+        ++_at;
+        return true;
+      }
+      return false;
+    }
+
+    void expect(char c)
+    {
+      if (!consume(c))
+        fail(std::string("'") + c + "'");
+    }
+
+    [[noreturn]] void fail(const std::string &expected) const
+    {
+      throw std::runtime_error("expected " + expected + " at offset " + std::to_string(_at));
+    }
+  };
+};
+
+} // namespace bench
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_BASELINE_H
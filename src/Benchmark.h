@@ -0,0 +1,520 @@
+#ifndef AISDI_LINEAR_BENCHMARK_H
+#define AISDI_LINEAR_BENCHMARK_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief keeps the compiler from optimizing away the computation of 'value'
+ */
+template <typename Type>
+inline void doNotOptimize(const Type &value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void *sink;
+  sink = &value;
+#endif
+}
+
+class State;
+
+/**
+ * @brief collects numbers beside the time of the timed code, allocation
+ *        counts for example. start() and stop() bracket every measure()
+ *        region of a run, so the clock does not see them, report() then
+ *        adds what the run collected as counters.
+ */
+class Probe
+{
+public:
+  virtual ~Probe() = default;
+
+  // called before every timed run
+  virtual void reset() {}
+  virtual void start() = 0;
+  virtual void stop() = 0;
+  virtual void report(State &state) = 0;
+};
+
+/**
+ * @brief handed to a benchmark on every run. The benchmark reads the size it
+ *        is run with and wraps the code to be timed in measure(), setting up
+ *        outside of it is not timed. Without measure() the whole run counts.
+ */
+class State
+{
+public:
+  explicit State(std::size_t size) : _size(size), _operations(size) {}
+
+  std::size_t size() const { return _size; }
+
+  /**
+   * @brief times 'fn', may be called more than once per run, the times add up
+   */
+  template <typename Fn>
+  void measure(Fn &&fn)
+  {
+    for (auto probe : _probes)
+      probe->start();
+
+    auto start = Clock::now();
+    fn();
+    _elapsed += Clock::now() - start;
+    _measured = true;
+
+    for (auto it = _probes.rbegin(); it != _probes.rend(); ++it)
+      (*it)->stop();
+  }
+
+  /**
+   * @brief number of operations the timed code performs, the cost per
+   *        operation is reported from it. Defaults to the size.
+   */
+  void setOperations(std::size_t operations) { _operations = operations; }
+  std::size_t operations() const { return _operations; }
+
+  /**
+   * @brief reports a value of the run next to the times, e.g. allocations,
+   *        the value of the last run is kept
+   */
+  void setCounter(const std::string &name, double value)
+  {
+    for (auto &counter : _counters)
+    {
+      if (counter.first == name)
+      {
+        counter.second = value;
+        return;
+      }
+    }
+    _counters.emplace_back(name, value);
+  }
+
+private:
+  std::size_t _size;
+  std::size_t _operations;
+  Clock::duration _elapsed{};
+  bool _measured = false;
+  std::vector<std::pair<std::string, double>> _counters;
+  std::vector<Probe *> _probes;
+
+  friend class Runner;
+};
+
+/**
+ * @brief statistics of the repeated runs of one benchmark at one size
+ */
+struct Result
+{
+  std::string name;
+  std::size_t size = 0;
+  std::size_t operations = 0;
+  std::size_t runs = 0;
+  double minNs = 0;
+  double medianNs = 0;
+  double meanNs = 0;
+  double stddevNs = 0;
+  // slowdown against a baseline still accepted, as a fraction
+  double tolerance = 0;
+  // set when the benchmark was registered with a tolerance of its own,
+  // only then the tolerance is saved with the result
+  bool ownTolerance = false;
+  std::vector<std::pair<std::string, double>> counters;
+
+  double nsPerOperation() const { return operations ? medianNs / operations : medianNs; }
+};
+
+struct Options
+{
+  // names containing any of the patterns are run, all when empty
+  std::vector<std::string> patterns;
+  // overrides the sizes every benchmark was registered with
+  std::vector<std::size_t> sizes;
+  std::size_t warmup = 1;
+  std::size_t repetitions = 5;
+  // results are written there, --save-baseline is another name for it
+  std::string jsonPath;
+  // results are checked against the baseline there, see Baseline.h
+  std::string comparePath;
+  // for benchmarks registered without a tolerance of their own
+  double tolerance = 0.2;
+  bool listOnly = false;
+  // asks for hardware counters, see PerfCounters.h
+  bool perf = false;
+
+  /**
+   * @brief reads [pattern...] [--sizes=N,M] [--warmup=N] [--repetitions=N]
+   *        [--json=path | --save-baseline=path] [--compare=path]
+   *        [--tolerance=percent] [--list] [--perf], throws
+   *        std::invalid_argument otherwise
+   */
+  static Options parse(int argc, char **argv)
+  {
+    Options options;
+    for (int i = 1; i < argc; ++i)
+    {
+      std::string arg = argv[i];
+      if (arg.rfind("--", 0) != 0)
+        options.patterns.push_back(arg);
+      else if (arg == "--list")
+        options.listOnly = true;
+      else if (arg == "--perf")
+        options.perf = true;
+      else if (arg.rfind("--sizes=", 0) == 0)
+        options.sizes = parseSizes(arg.substr(8));
+      else if (arg.rfind("--warmup=", 0) == 0)
+        options.warmup = parseNumber(arg.substr(9));
+      else if (arg.rfind("--repetitions=", 0) == 0)
+        options.repetitions = std::max<std::size_t>(1, parseNumber(arg.substr(14)));
+      else if (arg.rfind("--json=", 0) == 0)
+        options.jsonPath = arg.substr(7);
+      else if (arg.rfind("--save-baseline=", 0) == 0)
+        options.jsonPath = arg.substr(16);
+      else if (arg.rfind("--compare=", 0) == 0)
+        options.comparePath = arg.substr(10);
+      else if (arg.rfind("--tolerance=", 0) == 0)
+        options.tolerance = parsePercent(arg.substr(12));
+      else
+        throw std::invalid_argument("Unknown option " + arg);
+    }
+    return options;
+  }
+
+  bool selects(const std::string &name) const
+  {
+    if (patterns.empty())
+      return true;
+    return std::any_of(patterns.begin(), patterns.end(),
+                       [&name](const std::string &pattern) { return name.find(pattern) != std::string::npos; });
+  }
+
+private:
+  static std::size_t parseNumber(const std::string &text)
+  {
+    std::size_t used = 0;
+    auto value = std::stoull(text, &used);
+    if (used != text.size())
+      throw std::invalid_argument("Not a number: " + text);
+    return static_cast<std::size_t>(value);
+  }
+
+  // a fraction from a percentage, which may have decimals
+  static double parsePercent(const std::string &text)
+  {
+    std::size_t used = 0;
+    double value = -1;
+    try
+    {
+      value = std::stod(text, &used);
+    }
+    catch (const std::logic_error &)
+    {
+    }
+    if (used != text.size() || !std::isfinite(value) || value < 0)
+      throw std::invalid_argument("Not a percentage: " + text);
+    return value / 100.0;
+  }
+
+  static std::vector<std::size_t> parseSizes(const std::string &text)
+  {
+    std::vector<std::size_t> sizes;
+    std::istringstream stream(text);
+    for (std::string item; std::getline(stream, item, ',');)
+      sizes.push_back(parseNumber(item));
+    return sizes;
+  }
+};
+
+/**
+ * @brief keeps the registered benchmarks and runs them: each one at every
+ *        size, first 'warmup' runs whose times are dropped, then
+ *        'repetitions' timed ones.
+ */
+class Runner
+{
+public:
+  using Function = std::function<void(State &)>;
+
+  /**
+   * @brief 'tolerance' is the slowdown against a baseline accepted for
+   *        this benchmark as a fraction, 0 takes the one from the options
+   */
+  void add(std::string name, std::vector<std::size_t> sizes, Function function, double tolerance = 0)
+  {
+    _benchmarks.push_back({std::move(name), std::move(sizes), std::move(function), tolerance});
+  }
+
+  /**
+   * @brief 'probe' joins every timed run, it sees only measure() regions
+   */
+  void addProbe(std::unique_ptr<Probe> probe)
+  {
+    _probes.push_back(std::move(probe));
+  }
+
+  /**
+   * @brief runs what 'options' select, prints a table to 'out' as results
+   *        come and writes JSON if asked to
+   */
+  std::vector<Result> run(const Options &options, std::ostream &out = std::cout) const
+  {
+    std::vector<Result> results;
+    if (options.listOnly)
+    {
+      for (const auto &benchmark : _benchmarks)
+        if (options.selects(benchmark.name))
+          out << benchmark.name << '\n';
+      return results;
+    }
+
+    printHeader(out);
+    for (const auto &benchmark : _benchmarks)
+    {
+      if (!options.selects(benchmark.name))
+        continue;
+
+      const auto &sizes = options.sizes.empty() ? benchmark.sizes : options.sizes;
+      for (auto size : sizes)
+      {
+        results.push_back(runOne(benchmark, size, options));
+        printRow(out, results.back());
+      }
+    }
+
+    printRatios(out, results);
+
+    if (!options.jsonPath.empty())
+    {
+      std::ofstream file(options.jsonPath);
+      if (!file)
+        throw std::runtime_error("Cannot write " + options.jsonPath);
+      writeJson(file, results);
+    }
+    return results;
+  }
+
+  /**
+   * @brief prints, for every result with baselines at the same scenario and
+   *        size, its median divided by the median of each baseline. Names
+   *        read "scenario/container", baselines are the containers starting
+   *        with 'baselinePrefix'.
+   */
+  static void printRatios(std::ostream &out, const std::vector<Result> &results,
+                          const std::string &baselinePrefix = "std::")
+  {
+    auto isBaseline = [&baselinePrefix](const Result &result) {
+      return container(result.name).rfind(baselinePrefix, 0) == 0;
+    };
+
+    std::vector<std::string> baselines;
+    for (const auto &result : results)
+      if (isBaseline(result) &&
+          std::find(baselines.begin(), baselines.end(), container(result.name)) == baselines.end())
+        baselines.push_back(container(result.name));
+    if (baselines.empty())
+      return;
+
+    auto findBaseline = [&results](const Result &of, const std::string &baseline) -> const Result * {
+      for (const auto &result : results)
+        if (result.size == of.size && scenario(result.name) == scenario(of.name) &&
+            container(result.name) == baseline)
+          return &result;
+      return nullptr;
+    };
+
+    auto flags = out.flags();
+    out << "\nmedian time relative to the baseline, below 1 is faster\n"
+        << std::left << std::setw(48) << "benchmark" << std::right << std::setw(10) << "size";
+    for (const auto &baseline : baselines)
+      out << std::setw(16) << baseline;
+    out << "\n";
+
+    for (const auto &result : results)
+    {
+      if (isBaseline(result))
+        continue;
+
+      std::ostringstream row;
+      bool compared = false;
+      for (const auto &baseline : baselines)
+      {
+        const Result *other = findBaseline(result, baseline);
+        std::ostringstream cell;
+        if (other && other->medianNs > 0)
+        {
+          cell << std::fixed << std::setprecision(2) << result.medianNs / other->medianNs << "x";
+          compared = true;
+        }
+        else
+          cell << "-";
+        row << std::setw(16) << cell.str();
+      }
+
+      if (compared)
+        out << std::left << std::setw(48) << result.name << std::right << std::setw(10) << result.size
+            << row.str() << "\n";
+    }
+    out.flags(flags);
+  }
+
+  static void writeJson(std::ostream &out, const std::vector<Result> &results)
+  {
+    out << "{\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+      const auto &result = results[i];
+      out << (i ? ",\n" : "\n") << "    {\"name\": \"" << escape(result.name) << "\", \"size\": " << result.size
+          << ", \"operations\": " << result.operations << ", \"runs\": " << result.runs << std::fixed
+          << std::setprecision(1) << ", \"min_ns\": " << result.minNs << ", \"median_ns\": " << result.medianNs
+          << ", \"mean_ns\": " << result.meanNs << ", \"stddev_ns\": " << result.stddevNs
+          << std::setprecision(3) << ", \"ns_per_op\": " << result.nsPerOperation();
+      if (result.ownTolerance)
+        out << ", \"tolerance\": " << result.tolerance;
+      for (const auto &counter : result.counters)
+        out << ", \"" << escape(counter.first) << "\": " << counter.second;
+      out << "}";
+      out.unsetf(std::ios::floatfield);
+    }
+    out << "\n  ]\n}\n";
+  }
+
+private:
+  struct Benchmark
+  {
+    std::string name;
+    std::vector<std::size_t> sizes;
+    Function function;
+    double tolerance;
+  };
+
+  std::vector<Benchmark> _benchmarks;
+  std::vector<std::unique_ptr<Probe>> _probes;
+
+  Result runOne(const Benchmark &benchmark, std::size_t size, const Options &options) const
+  {
+    Result result;
+    result.name = benchmark.name;
+    result.size = size;
+    result.ownTolerance = benchmark.tolerance > 0;
+    result.tolerance = result.ownTolerance ? benchmark.tolerance : options.tolerance;
+
+    for (std::size_t i = 0; i < options.warmup; ++i)
+    {
+      State state(size);
+      benchmark.function(state);
+    }
+
+    std::vector<double> samples;
+    for (std::size_t i = 0; i < options.repetitions; ++i)
+    {
+      State state(size);
+      for (const auto &probe : _probes)
+      {
+        probe->reset();
+        state._probes.push_back(probe.get());
+      }
+
+      auto start = Clock::now();
+      benchmark.function(state);
+      auto elapsed = state._measured ? state._elapsed : Clock::now() - start;
+
+      for (auto probe : state._probes)
+        probe->report(state);
+
+      samples.push_back(std::chrono::duration<double, std::nano>(elapsed).count());
+      result.operations = state._operations;
+      result.counters = state._counters;
+    }
+
+    result.runs = samples.size();
+    std::sort(samples.begin(), samples.end());
+    result.minNs = samples.front();
+    auto middle = samples.size() / 2;
+    result.medianNs = samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2;
+
+    double sum = 0;
+    for (auto sample : samples)
+      sum += sample;
+    result.meanNs = sum / samples.size();
+
+    double squares = 0;
+    for (auto sample : samples)
+      squares += (sample - result.meanNs) * (sample - result.meanNs);
+    result.stddevNs = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0;
+
+    return result;
+  }
+
+  static void printHeader(std::ostream &out)
+  {
+    out << std::left << std::setw(48) << "benchmark" << std::right << std::setw(10) << "size" << std::setw(14)
+        << "median ms" << std::setw(12) << "min ms" << std::setw(10) << "stddev" << std::setw(12) << "ns/op"
+        << "\n";
+  }
+
+  static void printRow(std::ostream &out, const Result &result)
+  {
+    auto flags = out.flags();
+    out << std::left << std::setw(48) << result.name << std::right << std::setw(10) << result.size << std::fixed
+        << std::setprecision(3) << std::setw(14) << result.medianNs / 1e6 << std::setw(12) << result.minNs / 1e6
+        << std::setprecision(1) << std::setw(9) << (result.meanNs > 0 ? 100 * result.stddevNs / result.meanNs : 0)
+        << "%" << std::setprecision(2) << std::setw(12) << result.nsPerOperation();
+    for (const auto &counter : result.counters)
+    {
+      // counts print whole, ratios and per operation values do not
+      bool whole = counter.second == std::floor(counter.second);
+      out << "  " << counter.first << "=" << std::setprecision(whole ? 0 : 2) << counter.second;
+    }
+    out << std::endl;
+    out.flags(flags);
+  }
+
+  static std::string scenario(const std::string &name) { return name.substr(0, name.find('/')); }
+
+  static std::string container(const std::string &name)
+  {
+    auto slash = name.find('/');
+    return slash == std::string::npos ? std::string() : name.substr(slash + 1);
+  }
+
+  static std::string escape(const std::string &text)
+  {
+    std::string escaped;
+    for (char c : text)
+    {
+      if (c == '"' || c == '\\')
+        escaped += '\\';
+      escaped += c;
+    }
+    return escaped;
+  }
+};
+
+} // namespace bench
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_BENCHMARK_H
@@ -0,0 +1,32 @@
+#ifndef AISDI_LINEAR_CHECKS_H
+#define AISDI_LINEAR_CHECKS_H
+
+/*
+ * Index and iterator checks (dereferencing end(), stepping past either end,
+ * operator[] out of range) throw std::out_of_range when enabled. They are on
+ * by default and compiled out of release builds (NDEBUG), which leaves the
+ * iterators as bare pointer arithmetic. Define AISDI_LINEAR_CHECKED to 0 or 1
+ * to choose explicitly, using the same value in every translation unit.
+ *
+ * Checks of the container contract (popping or erasing from an empty
+ * container) are not affected and always throw.
+ */
+#ifndef AISDI_LINEAR_CHECKED
+#  ifdef NDEBUG
+#    define AISDI_LINEAR_CHECKED 0
+#  else
+#    define AISDI_LINEAR_CHECKED 1
+#  endif
+#endif
+
+namespace aisdi
+{
+namespace detail
+{
+
+constexpr bool checked = AISDI_LINEAR_CHECKED != 0;
+
+} // namespace detail
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_CHECKS_H
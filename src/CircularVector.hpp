@@ -0,0 +1,624 @@
+#ifndef AISDI_LINEAR_CIRCULARVECTOR_H
+#define AISDI_LINEAR_CIRCULARVECTOR_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <new>
+#include <utility>
+
+#include "Checks.h"
+#include "Vector.hpp"
+
+namespace aisdi
+{
+
+/**
+ * @brief Vector with ring buffer storage. Elements occupy the slots
+ *        [_head, _head + _size) modulo capacity, so both ends can grow and
+ *        shrink without shifting anything: append, prepend, popFirst and
+ *        popLast are amortized O(1). Insertion and erasure in the middle
+ *        shift whichever side of the position is shorter.
+ *
+ *        Capacity is always a power of two, which lets a logical index be
+ *        mapped to a slot with a single mask.
+ */
+template <typename Type>
+class CircularVector
+{
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type *;
+  using reference = Type &;
+  using const_pointer = const Type *;
+  using const_reference = const Type &;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  CircularVector() : _array(nullptr), _capacity(0), _head(0), _size(0) {}
+  CircularVector(std::initializer_list<Type> l)
+      : _array(allocate(roundUpCapacity(l.size()))), _capacity(roundUpCapacity(l.size())), _head(0), _size(0)
+  {
+    for (const auto &elem : l)
+      constructAtEnd(elem);
+  }
+  CircularVector(const CircularVector &other)
+      : _array(allocate(roundUpCapacity(other._size))), _capacity(roundUpCapacity(other._size)), _head(0), _size(0)
+  {
+    for (const auto &elem : other)
+      constructAtEnd(elem);
+  }
+  CircularVector(CircularVector &&other)
+      : _array(other._array), _capacity(other._capacity), _head(other._head), _size(other._size)
+  {
+    other._array = nullptr;
+    other._capacity = 0;
+    other._head = 0;
+    other._size = 0;
+  }
+  ~CircularVector()
+  {
+    destroyElements(0, _size);
+    deallocate(_array);
+  }
+
+  CircularVector &operator=(const CircularVector &other)
+  {
+    if (this == &other)
+      return *this;
+
+    if (_capacity < other._size)
+    {
+      // the copy is built before the old buffer is let go, so a throwing
+      // allocation or copy leaves this vector as it was
+      size_type newCapacity = roundUpCapacity(other._size);
+      Type *newArray = allocate(newCapacity);
+      size_type copied = 0;
+      try
+      {
+        for (; copied < other._size; ++copied)
+          new (newArray + copied) Type(other.at(copied));
+      }
+      catch (...)
+      {
+        for (size_type i = 0; i < copied; ++i)
+          newArray[i].~Type();
+        deallocate(newArray);
+        throw;
+      }
+
+      destroyElements(0, _size);
+      deallocate(_array);
+      _array = newArray;
+      _capacity = newCapacity;
+      _head = 0;
+      _size = other._size;
+      return *this;
+    }
+
+    destroyElements(0, _size);
+    _size = 0;
+    _head = 0;
+
+    for (const auto &elem : other)
+      constructAtEnd(elem);
+
+    return *this;
+  }
+  CircularVector &operator=(CircularVector &&other)
+  {
+    if (this == &other)
+      return *this;
+
+    destroyElements(0, _size);
+    deallocate(_array);
+
+    _array = other._array;
+    _capacity = other._capacity;
+    _head = other._head;
+    _size = other._size;
+
+    other._array = nullptr;
+    other._capacity = 0;
+    other._head = 0;
+    other._size = 0;
+
+    return *this;
+  }
+  Type &operator[](const size_type index)
+  {
+    checkIndex(index);
+    return at(index);
+  }
+  const Type &operator[](const size_type index) const
+  {
+    checkIndex(index);
+    return at(index);
+  }
+
+  bool isEmpty() const { return _size == 0; }
+  size_type getSize() const { return _size; }
+  size_type getCapacity() const { return _capacity; }
+
+  void append(const Type &item) { emplaceBack(item); }
+  void append(Type &&item) { emplaceBack(std::move(item)); }
+  void prepend(const Type &item) { emplaceFront(item); }
+  void prepend(Type &&item) { emplaceFront(std::move(item)); }
+  void insert(const const_iterator &insertPosition, const Type &item)
+  {
+    emplace(insertPosition, item);
+  }
+  void insert(const const_iterator &insertPosition, Type &&item)
+  {
+    emplace(insertPosition, std::move(item));
+  }
+
+  template <typename... Args>
+  Type &emplaceBack(Args &&... args)
+  {
+    if (_size == _capacity)
+      reallocateAndConstruct(false, std::forward<Args>(args)...);
+    else
+      constructAtEnd(std::forward<Args>(args)...);
+
+    return at(_size - 1);
+  }
+  template <typename... Args>
+  Type &emplaceFront(Args &&... args)
+  {
+    if (_size == _capacity)
+      reallocateAndConstruct(true, std::forward<Args>(args)...);
+    else
+      constructAtFront(std::forward<Args>(args)...);
+
+    return at(0);
+  }
+  template <typename... Args>
+  Type &emplace(const const_iterator &position, Args &&... args)
+  {
+    size_type index = position._position;
+
+    if (index == _size)
+      return emplaceBack(std::forward<Args>(args)...);
+    if (index == 0)
+      return emplaceFront(std::forward<Args>(args)...);
+
+    // built before shifting, args might refer to our own elements
+    Type temp(std::forward<Args>(args)...);
+
+    if (_size == _capacity)
+      changeCapacity(nextCapacity());
+
+    if (index < _size / 2)
+    {
+      // shift the front part one slot towards the beginning
+      new (slot(_capacity - 1)) Type(std::move(at(0)));
+      for (size_type i = 0; i + 1 < index; ++i)
+        at(i) = std::move(at(i + 1));
+      at(index - 1) = std::move(temp);
+      _head = wrap(_head + _capacity - 1);
+    }
+    else
+    {
+      // shift the back part one slot towards the end
+      new (slot(_size)) Type(std::move(at(_size - 1)));
+      for (size_type i = _size - 1; i > index; --i)
+        at(i) = std::move(at(i - 1));
+      at(index) = std::move(temp);
+    }
+    ++_size;
+
+    return at(index);
+  }
+
+  Type popFirst()
+  {
+    if (_size == 0)
+      throw std::length_error("Popped empty vector");
+
+    Type temp(std::move(at(0)));
+    at(0).~Type();
+    _head = wrap(_head + 1);
+    --_size;
+
+    shrinkIfSparse();
+
+    return temp;
+  }
+
+  Type popLast()
+  {
+    if (_size == 0)
+      throw std::length_error("Popped empty vector");
+
+    Type temp(std::move(at(_size - 1)));
+    at(_size - 1).~Type();
+    --_size;
+
+    shrinkIfSparse();
+
+    return temp;
+  }
+
+  void erase(const const_iterator &possition)
+  {
+    if (_size == 0)
+      throw std::out_of_range("Erasing empty vector");
+    if (possition._position >= _size)
+      throw std::out_of_range("Erasing end iterator");
+
+    eraseElements(possition._position, 1);
+  }
+  void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+  {
+    if (firstIncluded._position > lastExcluded._position || lastExcluded._position > _size)
+      throw std::out_of_range("Invalid range");
+
+    if (firstIncluded == lastExcluded)
+      return;
+
+    eraseElements(firstIncluded._position, lastExcluded._position - firstIncluded._position);
+  }
+
+  iterator       begin()        { return iterator(0, this); }
+  iterator       end()          { return iterator(_size, this); }
+  const_iterator cbegin() const { return const_iterator(0, this); }
+  const_iterator cend()   const { return const_iterator(_size, this); }
+  const_iterator begin()  const { return cbegin(); }
+  const_iterator end()    const { return cend(); }
+
+private:
+  // _array holds _capacity raw slots, the elements are constructed in
+  // [_head, _head + _size) taken modulo _capacity
+  Type*     _array;
+  size_type _capacity;
+  size_type _head;
+  size_type _size;
+
+  static const size_type _defaultCapacity = 8;
+
+  using Mover = detail::ElementMover<Type>;
+
+  /////////////////////////////////////////////
+  ///PRIVATE METHODS//////////////////////////
+  ////////////////////////////////////////////
+  static Type *allocate(size_type capacity)
+  {
+    if (capacity == 0)
+      return nullptr;
+
+    return static_cast<Type *>(::operator new(capacity * sizeof(Type)));
+  }
+  static void deallocate(Type *array)
+  {
+    ::operator delete(array);
+  }
+  static size_type roundUpCapacity(size_type size)
+  {
+    if (size == 0)
+      return 0;
+
+    size_type capacity = 1;
+    while (capacity < size)
+      capacity *= 2;
+    return capacity;
+  }
+
+  size_type wrap(size_type physicalIndex) const { return physicalIndex & (_capacity - 1); }
+  Type *slot(size_type index) const { return _array + wrap(_head + index); }
+  Type &at(size_type index) const { return *slot(index); }
+
+  void checkIndex(size_type index) const
+  {
+    if (detail::checked && index >= _size)
+      throw std::out_of_range("Index out of range");
+  }
+
+  size_type nextCapacity() const { return _capacity == 0 ? _defaultCapacity : _capacity * 2; }
+
+  void destroyElements(size_type fromIncluded, size_type toExcluded)
+  {
+    for (size_type i = fromIncluded; i < toExcluded; ++i)
+      at(i).~Type();
+  }
+  template <typename... Args>
+  void constructAtEnd(Args &&... args)
+  {
+    new (slot(_size)) Type(std::forward<Args>(args)...);
+    ++_size;
+  }
+  template <typename... Args>
+  void constructAtFront(Args &&... args)
+  {
+    size_type newHead = wrap(_head + _capacity - 1);
+    new (_array + newHead) Type(std::forward<Args>(args)...);
+    _head = newHead;
+    ++_size;
+  }
+
+  /**
+   * @brief removes 'count' elements starting at logical 'index',
+   *        closing the gap from the shorter side
+   */
+  void eraseElements(size_type index, size_type count)
+  {
+    size_type elementsAfter = _size - index - count;
+
+    if (index < elementsAfter)
+    {
+      for (size_type i = index; i > 0; --i)
+        at(i - 1 + count) = std::move(at(i - 1));
+      destroyElements(0, count);
+      _head = wrap(_head + count);
+    }
+    else
+    {
+      for (size_type i = index + count; i < _size; ++i)
+        at(i - count) = std::move(at(i));
+      destroyElements(_size - count, _size);
+    }
+    _size -= count;
+
+    shrinkIfSparse();
+  }
+
+  void shrinkIfSparse()
+  {
+    if (_capacity > _defaultCapacity && _size < _capacity / 4)
+      changeCapacity(_capacity / 2);
+  }
+
+  /**
+   * @brief moves the elements into 'newArray' starting at slot 0 and
+   *        releases the old buffer. The occupied part of the old buffer
+   *        is at most two contiguous runs.
+   */
+  void relocateInto(Type *newArray, size_type newCapacity)
+  {
+    if (_size != 0)
+    {
+      size_type firstRun = _capacity - _head < _size ? _capacity - _head : _size;
+      Mover::relocate(newArray, _array + _head, firstRun);
+      Mover::relocate(newArray + firstRun, _array, _size - firstRun);
+    }
+
+    deallocate(_array);
+    _array = newArray;
+    _capacity = newCapacity;
+    _head = 0;
+  }
+  void changeCapacity(size_type newCapacity)
+  {
+    relocateInto(allocate(newCapacity), newCapacity);
+  }
+  /**
+   * @brief grows the buffer and constructs a new element at the front or at
+   *        the back. The new element is built before the old buffer is
+   *        released, as 'args' might refer to our own elements.
+   */
+  template <typename... Args>
+  void reallocateAndConstruct(bool atFront, Args &&... args)
+  {
+    size_type newCapacity = nextCapacity();
+    Type *newArray = allocate(newCapacity);
+
+    new (newArray + (atFront ? newCapacity - 1 : _size)) Type(std::forward<Args>(args)...);
+    relocateInto(newArray, newCapacity);
+
+    if (atFront)
+      _head = newCapacity - 1;
+    ++_size;
+  }
+};
+
+template <typename Type>
+class CircularVector<Type>::ConstIterator
+{
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = typename CircularVector::value_type;
+  using difference_type = typename CircularVector::difference_type;
+  using pointer = typename CircularVector::const_pointer;
+  using reference = typename CircularVector::const_reference;
+
+  explicit ConstIterator() : _position(0), vec(nullptr) {}
+  explicit ConstIterator(size_type pos, const CircularVector<Type> *v) : _position(pos), vec(v) {}
+
+  reference operator*() const
+  {
+    if (detail::checked)
+    {
+      if (vec == nullptr)
+        throw std::out_of_range("Dereferencing uninitialized iterator");
+      if (_position >= vec->getSize())
+        throw std::out_of_range("Dereferencing end iterator");
+    }
+
+    return vec->at(_position);
+  }
+
+  reference operator[](difference_type d) const
+  {
+    return *(*this + d);
+  }
+
+  ConstIterator &operator++()
+  {
+    if (detail::checked && _position + 1 > vec->getSize())
+      throw std::out_of_range("Incrementing end iterator");
+
+    ++_position;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto temp = *this;
+    ++*this;
+    return temp;
+  }
+
+  ConstIterator &operator--()
+  {
+    if (detail::checked && _position == 0)
+      throw std::out_of_range("Decrementing begin iterator");
+
+    --_position;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto temp = *this;
+    --*this;
+    return temp;
+  }
+
+  ConstIterator &operator+=(difference_type d)
+  {
+    if (detail::checked)
+    {
+      if (d < 0 && static_cast<size_type>(-d) > _position)
+        throw std::out_of_range("Substracting iterator pass zero");
+      if (d > 0 && _position + d > vec->getSize())
+        throw std::out_of_range("Adding to iterator passed the end");
+    }
+
+    _position += d;
+    return *this;
+  }
+
+  ConstIterator &operator-=(difference_type d)
+  {
+    return *this += -d;
+  }
+
+  ConstIterator operator+(difference_type d) const
+  {
+    auto temp = *this;
+    return temp += d;
+  }
+
+  ConstIterator operator-(difference_type d) const
+  {
+    auto temp = *this;
+    return temp -= d;
+  }
+
+  difference_type operator-(const ConstIterator &other) const
+  {
+    return static_cast<difference_type>(_position) - static_cast<difference_type>(other._position);
+  }
+
+  bool operator==(const ConstIterator &other) const
+  {
+    return vec == other.vec && _position == other._position;
+  }
+
+  bool operator!=(const ConstIterator &other) const
+  {
+    return !(*this == other);
+  }
+
+  bool operator<(const ConstIterator &other) const { return _position < other._position; }
+  bool operator>(const ConstIterator &other) const { return other < *this; }
+  bool operator<=(const ConstIterator &other) const { return !(other < *this); }
+  bool operator>=(const ConstIterator &other) const { return !(*this < other); }
+
+protected:
+  friend class CircularVector;
+
+  size_type _position;
+  const CircularVector<Type> *vec;
+};
+
+template <typename Type>
+class CircularVector<Type>::Iterator : public CircularVector<Type>::ConstIterator
+{
+public:
+  using pointer = typename CircularVector::pointer;
+  using reference = typename CircularVector::reference;
+  using size_type = typename CircularVector::size_type;
+
+  explicit Iterator() : ConstIterator()
+  {
+  }
+
+  Iterator(size_type pos, CircularVector<Type> *v) : ConstIterator(pos, v) {}
+
+  Iterator(const ConstIterator &other)
+      : ConstIterator(other)
+  {
+  }
+
+  Iterator &operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator &operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator &operator+=(difference_type d)
+  {
+    ConstIterator::operator+=(d);
+    return *this;
+  }
+
+  Iterator &operator-=(difference_type d)
+  {
+    ConstIterator::operator-=(d);
+    return *this;
+  }
+
+  Iterator operator+(difference_type d) const
+  {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const
+  {
+    return ConstIterator::operator-(d);
+  }
+
+  using ConstIterator::operator-;
+
+  reference operator*() const
+  {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+
+  reference operator[](difference_type d) const
+  {
+    return *(*this + d);
+  }
+};
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_CIRCULARVECTOR_H
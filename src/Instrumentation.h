@@ -0,0 +1,223 @@
+#ifndef AISDI_LINEAR_INSTRUMENTATION_H
+#define AISDI_LINEAR_INSTRUMENTATION_H
+
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+/*
+ * Allocation counters of Vector and LinkedList, kept for every container and
+ * summed up for the whole program. They are off by default, define
+ * AISDI_LINEAR_INSTRUMENTED to 1 to turn them on, using the same value in
+ * every translation unit. Turned off, the per-container counter is an empty
+ * base class and every hook an empty inline function, so nothing is left of
+ * them in the compiled code.
+ *
+ * What counts as an allocation differs: for Vector it is a heap buffer taken
+ * from the allocator, for LinkedList a node, the guard included, even though
+ * the node pool takes its memory from the allocator slab by slab.
+ */
+#ifndef AISDI_LINEAR_INSTRUMENTED
+#  define AISDI_LINEAR_INSTRUMENTED 0
+#endif
+
+namespace aisdi
+{
+
+struct AllocationStats
+{
+  std::size_t allocations = 0;
+  std::size_t frees = 0;
+  std::size_t bytesAllocated = 0;
+  // new buffers the elements were moved to, always 0 for LinkedList
+  std::size_t reallocations = 0;
+  // elements moved to another buffer, by reallocations or by moving
+  // a vector whose buffer cannot be taken over
+  std::size_t elementsRelocated = 0;
+  std::size_t bytesInUse = 0;
+  std::size_t peakBytes = 0;
+};
+
+namespace detail
+{
+
+constexpr bool instrumented = AISDI_LINEAR_INSTRUMENTED != 0;
+
+/**
+ * @brief counters of all containers together, updated from any thread
+ */
+class GlobalAllocationCounters
+{
+public:
+  static GlobalAllocationCounters &instance()
+  {
+    static GlobalAllocationCounters counters;
+    return counters;
+  }
+
+  void allocated(std::size_t bytes, std::size_t count)
+  {
+    _allocations.fetch_add(count, std::memory_order_relaxed);
+    _bytesAllocated.fetch_add(bytes, std::memory_order_relaxed);
+    auto inUse = _bytesInUse.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    auto peak = _peakBytes.load(std::memory_order_relaxed);
+    while (peak < inUse && !_peakBytes.compare_exchange_weak(peak, inUse, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  void freed(std::size_t bytes, std::size_t count)
+  {
+    _frees.fetch_add(count, std::memory_order_relaxed);
+    _bytesInUse.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  void relocated(std::size_t reallocations, std::size_t elements)
+  {
+    _reallocations.fetch_add(reallocations, std::memory_order_relaxed);
+    _elementsRelocated.fetch_add(elements, std::memory_order_relaxed);
+  }
+
+  AllocationStats stats() const
+  {
+    AllocationStats stats;
+    stats.allocations = _allocations.load(std::memory_order_relaxed);
+    stats.frees = _frees.load(std::memory_order_relaxed);
+    stats.bytesAllocated = _bytesAllocated.load(std::memory_order_relaxed);
+    stats.reallocations = _reallocations.load(std::memory_order_relaxed);
+    stats.elementsRelocated = _elementsRelocated.load(std::memory_order_relaxed);
+    stats.bytesInUse = _bytesInUse.load(std::memory_order_relaxed);
+    stats.peakBytes = _peakBytes.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  /**
+   * @brief zeroes the event counts and lowers the peak to what is in use
+   */
+  void reset()
+  {
+    _allocations.store(0, std::memory_order_relaxed);
+    _frees.store(0, std::memory_order_relaxed);
+    _bytesAllocated.store(0, std::memory_order_relaxed);
+    _reallocations.store(0, std::memory_order_relaxed);
+    _elementsRelocated.store(0, std::memory_order_relaxed);
+    _peakBytes.store(_bytesInUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+private:
+  std::atomic<std::size_t> _allocations{0};
+  std::atomic<std::size_t> _frees{0};
+  std::atomic<std::size_t> _bytesAllocated{0};
+  std::atomic<std::size_t> _reallocations{0};
+  std::atomic<std::size_t> _elementsRelocated{0};
+  std::atomic<std::size_t> _bytesInUse{0};
+  std::atomic<std::size_t> _peakBytes{0};
+};
+
+/**
+ * @brief counters of one container, which derives from it. Turned off it is
+ *        empty, like IndexLinks<false>, and takes no space in the container.
+ */
+template <bool Enabled = instrumented>
+class AllocationCounter
+{
+protected:
+  void countAllocation(std::size_t, std::size_t = 1) {}
+  void countFree(std::size_t, std::size_t = 1) {}
+  void countReallocation(std::size_t) {}
+  void countRelocation(std::size_t) {}
+  void countTransfer(AllocationCounter &, std::size_t) {}
+  AllocationStats allocationStats() const { return {}; }
+};
+
+static_assert(std::is_empty<AllocationCounter<false>>::value, "Disabled counters have to take no space");
+
+/**
+ * @brief counts are not copied with the container, a copy starts from zero.
+ *        Memory handed from one container to another without allocating,
+ *        by moving or splicing, goes over with countTransfer().
+ */
+template <>
+class AllocationCounter<true>
+{
+protected:
+  AllocationCounter() = default;
+  AllocationCounter(const AllocationCounter &) {}
+  AllocationCounter &operator=(const AllocationCounter &) { return *this; }
+
+  void countAllocation(std::size_t bytes, std::size_t count = 1)
+  {
+    _stats.allocations += count;
+    _stats.bytesAllocated += bytes;
+    take(bytes);
+    GlobalAllocationCounters::instance().allocated(bytes, count);
+  }
+
+  void countFree(std::size_t bytes, std::size_t count = 1)
+  {
+    _stats.frees += count;
+    _stats.bytesInUse -= bytes;
+    GlobalAllocationCounters::instance().freed(bytes, count);
+  }
+
+  /**
+   * @brief a new buffer that 'elements' were moved to
+   */
+  void countReallocation(std::size_t elements)
+  {
+    ++_stats.reallocations;
+    _stats.elementsRelocated += elements;
+    GlobalAllocationCounters::instance().relocated(1, elements);
+  }
+
+  void countRelocation(std::size_t elements)
+  {
+    _stats.elementsRelocated += elements;
+    GlobalAllocationCounters::instance().relocated(0, elements);
+  }
+
+  void countTransfer(AllocationCounter &from, std::size_t bytes)
+  {
+    from._stats.bytesInUse -= bytes;
+    take(bytes);
+  }
+
+  AllocationStats allocationStats() const { return _stats; }
+
+private:
+  AllocationStats _stats;
+
+  void take(std::size_t bytes)
+  {
+    _stats.bytesInUse += bytes;
+    if (_stats.bytesInUse > _stats.peakBytes)
+      _stats.peakBytes = _stats.bytesInUse;
+  }
+};
+
+} // namespace detail
+
+/**
+ * @brief counters of all Vectors and LinkedLists together, all zero unless
+ *        AISDI_LINEAR_INSTRUMENTED is set
+ */
+inline AllocationStats globalAllocationStats()
+{
+  if constexpr (detail::instrumented)
+    return detail::GlobalAllocationCounters::instance().stats();
+  else
+    return {};
+}
+
+/**
+ * @brief starts counting anew, the bytes in use stay and become the peak
+ */
+inline void resetGlobalAllocationStats()
+{
+  if constexpr (detail::instrumented)
+    detail::GlobalAllocationCounters::instance().reset();
+}
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_INSTRUMENTATION_H
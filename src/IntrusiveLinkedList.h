@@ -0,0 +1,392 @@
+#ifndef AISDI_LINEAR_INTRUSIVELINKEDLIST_H
+#define AISDI_LINEAR_INTRUSIVELINKEDLIST_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Checks.h"
+#include "ListNode.h"
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+/**
+ * @brief the list a hook is linked into, kept only in checked builds to
+ *        catch erasing an object through a list it is not in. Unchecked
+ *        it is empty, like IndexLinks<false>, and takes no space.
+ */
+template <bool Checked>
+struct HookListTag
+{
+  void tag(const void *) {}
+  bool taggedWith(const void *) const { return true; }
+};
+
+template <>
+struct HookListTag<true>
+{
+  void tag(const void *list) { _list = list; }
+  bool taggedWith(const void *list) const { return _list == list; }
+
+private:
+  const void *_list = nullptr;
+};
+
+static_assert(std::is_empty<HookListTag<false>>::value, "Unchecked hooks have to take no space for the tag");
+
+} // namespace detail
+
+class IntrusiveListHook;
+
+template <typename Type, IntrusiveListHook Type::*Hook>
+class IntrusiveLinkedList;
+
+/**
+ * @brief member that lets an object be linked into an IntrusiveLinkedList,
+ *        one hook per list the object may be in at the same time.
+ *
+ *        Besides the links it keeps a pointer back to the object, so that
+ *        the list gets from a hook to its object without knowing the layout
+ *        of Type. Copying an object does not copy its membership, the copy
+ *        starts unlinked. An object must be erased from its list before it
+ *        dies.
+ */
+class IntrusiveListHook : public detail::ListNode<IntrusiveListHook>, public detail::HookListTag<detail::checked>
+{
+public:
+  IntrusiveListHook() = default;
+  IntrusiveListHook(const IntrusiveListHook &) {}
+  IntrusiveListHook &operator=(const IntrusiveListHook &) { return *this; }
+
+  bool isLinked() const { return next != nullptr; }
+
+private:
+  template <typename Type, IntrusiveListHook Type::*Hook>
+  friend class IntrusiveLinkedList;
+
+  // the object the hook is a member of, set when it is linked
+  void *_object = nullptr;
+};
+
+/**
+ * @brief doubly linked list of objects that carry their own links in the
+ *        'Hook' member, e.g. IntrusiveLinkedList<Task, &Task::hook>.
+ *
+ *        The list neither owns nor allocates anything: inserting links the
+ *        object itself, erasing only unlinks it, so both are O(1) and never
+ *        allocate, also when erasing by reference. The guard is a hook inside
+ *        the list, so Type needs no default constructor. Destroying or
+ *        clearing the list unlinks all of its objects. Checked builds tag
+ *        every hook with its list, so moving a list takes O(n) there.
+ */
+template <typename Type, IntrusiveListHook Type::*Hook>
+class IntrusiveLinkedList
+{
+  using Node = IntrusiveListHook;
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type *;
+  using reference = Type &;
+  using const_pointer = const Type *;
+  using const_reference = const Type &;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  IntrusiveLinkedList() : _size(0)
+  {
+    _guard.connectWith(&_guard);
+  }
+  IntrusiveLinkedList(const IntrusiveLinkedList &) = delete;
+  IntrusiveLinkedList(IntrusiveLinkedList &&other) : IntrusiveLinkedList()
+  {
+    takeObjectsOf(other);
+  }
+  ~IntrusiveLinkedList()
+  {
+    clear();
+  }
+
+  IntrusiveLinkedList &operator=(const IntrusiveLinkedList &) = delete;
+  IntrusiveLinkedList &operator=(IntrusiveLinkedList &&other)
+  {
+    if (this != &other)
+    {
+      clear();
+      takeObjectsOf(other);
+    }
+    return *this;
+  }
+
+  bool isEmpty() const { return _size == 0; }
+  size_type getSize() const { return _size; }
+
+  /**
+   * @brief unlinks every object, O(n) as each hook is reset
+   */
+  void clear()
+  {
+    for (Node *node = _guard.next; node != &_guard;)
+    {
+      Node *next = node->next;
+      node->next = nullptr;
+      node->prev = nullptr;
+      node = next;
+    }
+    _guard.connectWith(&_guard);
+    _size = 0;
+  }
+
+  void append(Type &item) { link(&_guard, item); }
+  void prepend(Type &item) { link(_guard.next, item); }
+  void insert(const const_iterator &insertPosition, Type &item)
+  {
+    link(iterator(insertPosition).node(), item);
+  }
+
+  Type &popFirst()
+  {
+    if (_size == 0)
+      throw std::out_of_range("Popped empty list");
+
+    return unlink(_guard.next);
+  }
+
+  Type &popLast()
+  {
+    if (_size == 0)
+      throw std::out_of_range("Popped empty list");
+
+    return unlink(_guard.prev);
+  }
+
+  void erase(const const_iterator &position)
+  {
+    if (_size == 0)
+      throw std::out_of_range("Erasing empty list");
+    if (position == end())
+      throw std::out_of_range("Erasing end iterator");
+
+    unlink(iterator(position).node());
+  }
+
+  /**
+   * @brief unlinks 'item', which has to be in this list, in O(1). Checked
+   *        builds throw if it is linked into another one.
+   */
+  void erase(Type &item)
+  {
+    Node *node = &(item.*Hook);
+    if (!node->isLinked())
+      throw std::out_of_range("Erasing unlinked object");
+    if (detail::checked && !node->taggedWith(this))
+      throw std::out_of_range("Erasing object of another list");
+
+    unlink(node);
+  }
+
+  /**
+   * @brief iterator to 'item', which has to be in this list, in O(1)
+   */
+  iterator iteratorTo(Type &item) { return iterator(&(item.*Hook), &_guard); }
+  const_iterator iteratorTo(const Type &item) const { return const_iterator(&(item.*Hook), &_guard); }
+
+  iterator begin() { return iterator(_guard.next, &_guard); }
+  iterator end() { return iterator(&_guard, &_guard); }
+  const_iterator cbegin() const { return const_iterator(_guard.next, &_guard); }
+  const_iterator cend() const { return const_iterator(&_guard, &_guard); }
+  const_iterator begin() const { return cbegin(); }
+  const_iterator end() const { return cend(); }
+
+private:
+  Node _guard;
+  size_type _size;
+
+  static Type *owner(const Node *node)
+  {
+    return static_cast<Type *>(node->_object);
+  }
+
+  void link(Node *right, Type &item)
+  {
+    Node *node = &(item.*Hook);
+    if (node->isLinked())
+      throw std::logic_error("Object is already linked into a list");
+
+    node->insertInBetween(right->prev, right);
+    node->_object = &item;
+    node->tag(this);
+    ++_size;
+  }
+
+  Type &unlink(Node *node)
+  {
+    node->disconnect();
+    --_size;
+    return *owner(node);
+  }
+
+  void takeObjectsOf(IntrusiveLinkedList &other)
+  {
+    if (other._size == 0)
+      return;
+
+    Node *first = other._guard.next, *last = other._guard.prev;
+    if (detail::checked)
+      for (Node *node = first; node != &other._guard; node = node->next)
+        node->tag(this);
+    other._guard.connectWith(&other._guard);
+    _guard.connectWith(first);
+    last->connectWith(&_guard);
+
+    _size = other._size;
+    other._size = 0;
+  }
+};
+
+template <typename Type, IntrusiveListHook Type::*Hook>
+class IntrusiveLinkedList<Type, Hook>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename IntrusiveLinkedList::value_type;
+  using difference_type = typename IntrusiveLinkedList::difference_type;
+  using pointer = typename IntrusiveLinkedList::const_pointer;
+  using reference = typename IntrusiveLinkedList::const_reference;
+
+  explicit ConstIterator() : _node(nullptr), _guard(nullptr) {}
+  explicit ConstIterator(const Node *node, const Node *guard) : _node(node), _guard(guard) {}
+
+  reference operator*() const
+  {
+    if (detail::checked)
+    {
+      if (_node == nullptr)
+        throw std::out_of_range("Dereferencing uninitialized iterator");
+      if (_node == _guard)
+        throw std::out_of_range("Dereferencing end iterator");
+    }
+
+    return *owner(_node);
+  }
+
+  pointer operator->() const
+  {
+    return &**this;
+  }
+
+  ConstIterator &operator++()
+  {
+    if (detail::checked && _node == _guard)
+      throw std::out_of_range("Incrementing end iterator");
+
+    _node = _node->next;
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto temp = *this;
+    ++*this;
+    return temp;
+  }
+
+  ConstIterator &operator--()
+  {
+    if (detail::checked && _node->prev == _guard)
+      throw std::out_of_range("Decrementing begin iterator");
+
+    _node = _node->prev;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto temp = *this;
+    --*this;
+    return temp;
+  }
+
+  bool operator==(const ConstIterator &other) const
+  {
+    return _node == other._node;
+  }
+
+  bool operator!=(const ConstIterator &other) const
+  {
+    return !(*this == other);
+  }
+
+protected:
+  const Node *_node;
+  const Node *_guard;
+
+  friend class IntrusiveLinkedList;
+};
+
+template <typename Type, IntrusiveListHook Type::*Hook>
+class IntrusiveLinkedList<Type, Hook>::Iterator : public IntrusiveLinkedList<Type, Hook>::ConstIterator
+{
+public:
+  using pointer = typename IntrusiveLinkedList::pointer;
+  using reference = typename IntrusiveLinkedList::reference;
+
+  explicit Iterator(const Node *node, const Node *guard) : ConstIterator(node, guard) {}
+
+  Iterator(const ConstIterator &other) : ConstIterator(other) {}
+
+  Iterator &operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator &operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  reference operator*() const
+  {
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+
+  pointer operator->() const
+  {
+    return &**this;
+  }
+
+private:
+  Node *node() { return const_cast<Node *>(this->_node); }
+
+  friend class IntrusiveLinkedList;
+};
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_INTRUSIVELINKEDLIST_H
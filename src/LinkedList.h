@@ -2,82 +2,65 @@
 #define AISDI_LINEAR_LINKEDLIST_H
 
 #include <cstddef>
+#include <functional>
 #include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
 #include <stdexcept>
+#include <type_traits>
 #include <utility>
+
+#include "BackgroundReclaimer.h"
+#include "Instrumentation.h"
+#include "ListNode.h"
+#include "NodePool.h"
+#include "PositionIndex.h"
+#include "Prefetch.h"
+
 namespace aisdi
 {
 
-template <typename Type>
-class LinkedList
+/**
+ * @brief doubly linked list with a guard node. Nodes are taken from
+ *        a NodePool, which gets its slabs from 'Allocator' rebound to the
+ *        node type. Nodes moved to another list by splice(), splitAt() or
+ *        concat() are relinked and stay in the slabs they were cut from,
+ *        which both lists then share. Every list keeps its own pool and
+ *        the lists can be used from different threads, see NodePool for
+ *        how shared slabs are freed. The allocator follows the list
+ *        through copies, moves and assignments as its
+ *        propagate_on_container_* traits say.
+ *
+ *        With 'Indexed' set, nodes also form a detail::PositionIndex, which
+ *        makes operator[], iterator arithmetic and so insertion or erasure
+ *        at a given index O(log n), at the cost of four words per node and
+ *        O(log n) index upkeep in every insertion and erasure. Splicing a
+ *        range between lists and splitAt() are O(log n) then as well.
+ *
+ *        With AISDI_LINEAR_INSTRUMENTED set, the list counts the nodes it
+ *        allocates and frees, see Instrumentation.h.
+ */
+template <typename Type, typename Allocator = std::allocator<Type>, bool Indexed = false>
+class LinkedList : private detail::AllocationCounter<>
 {
-  struct Node
+  using Index = detail::PositionIndex;
+
+  struct Node : detail::ListNode<Node>, detail::IndexLinks<Indexed>
   {
     Node() = default;
-    Node(const Type &elem) : elem(elem), next(nullptr), prev(nullptr){};
-
-    /**
-     * @brief inserts itself between two other nodes, assumes that
-     *        other nodes are connected
-     * 
-     *             ----                        ->  ----  <----
-     *            |this|                       |  |this|-     |
-     *             ----                        |   ----  |    |
-     *                                         |  |      |    |
-     *                                         |  |      |    |
-     *                                         |  \/     \/   |
-     *        ----   --->  -----              ----         -----
-     *       |left|       |right|   =====>   |left|       |right|
-     *        ----   <---  -----              ----         -----
-     * 
-     * @param left 
-     * @param right 
-     */
-    void insertInBetween(Node *left, Node *right)
-    {
-      left->next = this;
-      this->prev = left;
-
-      right->prev = this;
-      this->next = right;
-    }
-
-    void connectWith(Node *other)
-    {
-      next = other;
-      other->prev = this;
-    }
-
-    /**
-     * @brief disconnects itself from two other nodes, prev and next
-     *  ->  ----  <----                          ---- 
-     *  |  |this|-     |                        |this|
-     *  |   ----  |    |                         ----
-     *  |  |      |    |
-     *  |  |      |    |        =======>
-     *  |  \/     \/   |                    -----   --->  -----
-     *  ----         -----                  |left|       |right|
-     *  |left|       |right|                -----   <---  -----
-     *  ----         -----
-     * 
-     */
-    void disconnect()
-    {
-      auto left = prev, right = next;
-      prev = nullptr;
-      next = nullptr;
-      if (left)
-        left->connectWith(right);
-      else if (right)
-        right->connectWith(left);
-    }
+    template <typename... Args>
+    explicit Node(Args &&... args) : elem(std::forward<Args>(args)...){};
 
     Type elem;
-    Node *next = nullptr;
-    Node *prev = nullptr;
   };
 
+  using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeAllocatorTraits = std::allocator_traits<NodeAllocator>;
+
 public:
+  using allocator_type = Allocator;
   using difference_type = std::ptrdiff_t;
   using size_type = std::size_t;
   using value_type = Type;
@@ -91,39 +74,62 @@ public:
   using iterator = Iterator;
   using const_iterator = ConstIterator;
 
-  LinkedList() :guard_(new Node), _size(0)
+  LinkedList() : LinkedList(Allocator()) {}
+
+  explicit LinkedList(const Allocator &allocator)
+      : LinkedList(allocator, Pool::create(NodeAllocator(allocator)))
   {
-    guard_->next = guard_;
-    guard_->prev = guard_;
   }
 
-  LinkedList(std::initializer_list<Type> l) : LinkedList()
+  LinkedList(std::initializer_list<Type> l, const Allocator &allocator = Allocator())
+      : LinkedList(l.begin(), l.end(), allocator)
   {
-    for (const auto &elem : l)
-    {
-      append(elem);
-    }
   }
 
-  LinkedList(const LinkedList &other) : LinkedList()
+  /**
+   * @brief copies [first, last). For forward iterators all nodes come from
+   *        one slab, allocated once and filled in list order, see reserve().
+   */
+  template <typename InputIt, typename = typename std::iterator_traits<InputIt>::iterator_category>
+  LinkedList(InputIt first, InputIt last, const Allocator &allocator = Allocator())
+      : LinkedList(allocator)
+  {
+    using Category = typename std::iterator_traits<InputIt>::iterator_category;
+    if constexpr (std::is_base_of_v<std::forward_iterator_tag, Category>)
+      reserve(static_cast<size_type>(std::distance(first, last)));
+
+    for (; first != last; ++first)
+      emplaceBack(*first);
+  }
+
+  LinkedList(const LinkedList &other)
+      : LinkedList(other, NodeAllocatorTraits::select_on_container_copy_construction(other._allocator))
   {
+  }
+
+  LinkedList(const LinkedList &other, const Allocator &allocator) : LinkedList(allocator)
+  {
+    reserve(other._size);
     for (const auto &elem : other)
     {
       append(elem);
     }
   }
 
-  LinkedList(LinkedList &&other) : guard_(other.guard_), _size(other._size)
+  LinkedList(LinkedList &&other)
+      : _allocator(other._allocator), _pool(std::move(other._pool)), guard_(other.guard_), _size(other._size)
   {
+    countTransfer(other, (_size + 1) * sizeof(Node));
     other.guard_ = nullptr;
+    other._size = 0;
   }
 
   ~LinkedList()
   {
     if (guard_)
     {
-      deleteNodesFrom(guard_->next, guard_);
-      delete guard_;
+      destroyAllNodes();
+      destroyGuard(guard_);
     }
   }
 
@@ -133,8 +139,23 @@ public:
       return *this;
 
     deleteNodesFrom(guard_->next, guard_);
-    guard_->connectWith(guard_);
-    _size = 0;
+    unlinkAll();
+
+    if constexpr (NodeAllocatorTraits::propagate_on_container_copy_assignment::value)
+    {
+      // the guard and the slabs go back to the allocator they came from,
+      // the new ones are made first so that a throw leaves this list empty
+      if (_allocator != other._allocator)
+      {
+        NodeAllocator allocator(other._allocator);
+        auto pool = Pool::create(allocator);
+        Node *guard = createGuard(allocator);
+        destroyGuard(guard_);
+        _allocator = allocator;
+        _pool = std::move(pool);
+        guard_ = guard;
+      }
+    }
 
     for (const auto &item : other)
       append(item);
@@ -147,22 +168,103 @@ public:
     if (this == &other)
       return *this;
 
-    deleteNodesFrom(guard_->next, guard_);
-    guard_->connectWith(guard_);
+    destroyAllNodes();
+
+    if constexpr (NodeAllocatorTraits::propagate_on_container_move_assignment::value)
+    {
+      // allocators travel with the nodes, 'other' frees our old guard
+      using std::swap;
+      swap(_allocator, other._allocator);
+    }
+    else if (_allocator != other._allocator)
+    {
+      // nodes of 'other' cannot be freed by our allocator, move the values
+      for (auto &item : other)
+        append(std::move(item));
+
+      other.destroyAllNodes();
+
+      return *this;
+    }
 
     std::swap(guard_, other.guard_);
+    std::swap(_pool, other._pool);
     _size = other._size;
+    other._size = 0;
+    // the guards were swapped as well, only the nodes changed hands
+    countTransfer(other, _size * sizeof(Node));
 
     return *this;
   }
 
   bool isEmpty() const { return _size == 0; }
   size_type getSize() const { return _size; }
+  allocator_type getAllocator() const { return allocator_type(_allocator); }
+  AllocationStats getAllocationStats() const { return allocationStats(); }
+
+  /**
+   * @brief removes all elements and gives the memory of their nodes back
+   *        to the allocator, unlike erase() which keeps it for reuse
+   */
+  void clear()
+  {
+    destroyAllNodes();
+  }
+
+  /**
+   * @brief empties the list in O(1) and leaves destroying the elements and
+   *        freeing the nodes to the BackgroundReclaimer thread, so the
+   *        allocator has to be usable from there. The list gets a fresh
+   *        guard and pool.
+   */
+  void releaseAsync()
+  {
+    if (_size == 0)
+      return clear();
+
+    auto freshPool = Pool::create(_allocator);
+    Node *freshGuard = createGuard();
+    std::unique_ptr<LinkedList> doomed;
+    try
+    {
+      doomed.reset(new LinkedList(std::move(*this)));
+    }
+    catch (...)
+    {
+      destroyGuard(freshGuard);
+      throw;
+    }
+
+    _pool = std::move(freshPool);
+    guard_ = freshGuard;
+    _size = 0;
+
+    // if deferring fails the old nodes are freed here after all
+    BackgroundReclaimer::instance().defer([list = doomed.get()] { delete list; });
+    doomed.release();
+  }
+
+  /**
+   * @brief prepares room for 'count' more nodes in a single slab, so that
+   *        adding that many elements takes at most one allocation and
+   *        nodes appended one after another lie next to each other in
+   *        memory. Nodes freed earlier are still reused first.
+   */
+  void reserve(size_type count)
+  {
+    _pool->reserve(count);
+  }
 
   Type &operator[](int pos) //to delete
   {
     if (!guard_)
       throw std::runtime_error("Referencing deleted object");
+    if constexpr (Indexed)
+    {
+      if (pos < 0 || static_cast<size_type>(pos) >= _size)
+        throw std::out_of_range("Index out of range0");
+      return static_cast<Node *>(Index::select(guard_, pos))->elem;
+    }
     int i = 0;
     for (auto it = guard_->next; it && it != guard_; it = it->next, ++i)
     {
@@ -172,29 +274,41 @@ public:
     throw std::out_of_range("Index out of range0");
   }
 
-  void append(const Type &item)
+  void append(const Type &item) { emplaceBack(item); }
+  void append(Type &&item) { emplaceBack(std::move(item)); }
+  void prepend(const Type &item) { emplaceFront(item); }
+  void prepend(Type &&item) { emplaceFront(std::move(item)); }
+  void insert(const const_iterator &insertPosition, const Type &item)
   {
-    Node *newElem = new Node(item);
-    newElem->insertInBetween(guard_->prev, guard_);
-    ++_size;
+    emplace(insertPosition, item);
   }
-
-  void prepend(const Type &item)
+  void insert(const const_iterator &insertPosition, Type &&item)
   {
-    Node *newElem = new Node(item);
-    newElem->insertInBetween(guard_, guard_->next);
-    ++_size;
+    emplace(insertPosition, std::move(item));
   }
 
-  void insert(const const_iterator &insertPosition, const Type &item)
+  /**
+   * @brief constructs a new last element in place, 'args' are
+   *        forwarded to the constructor of Type
+   * @return reference to the new element
+   */
+  template <typename... Args>
+  Type &emplaceBack(Args &&... args)
   {
-    Node *newElem = new Node(item);
+    return emplaceBetween(guard_->prev, guard_, std::forward<Args>(args)...);
+  }
 
-    auto right = iterator(insertPosition).node();
-    auto left = right->prev;
+  template <typename... Args>
+  Type &emplaceFront(Args &&... args)
+  {
+    return emplaceBetween(guard_, guard_->next, std::forward<Args>(args)...);
+  }
 
-    newElem->insertInBetween(left, right);
-    _size++;
+  template <typename... Args>
+  Type &emplace(const const_iterator &position, Args &&... args)
+  {
+    auto right = iterator(position).node();
+    return emplaceBetween(right->prev, right, std::forward<Args>(args)...);
   }
 
   Type popFirst()
@@ -236,11 +350,255 @@ public:
     auto itLast = iterator(lastExcluded);
 
     auto first = itFirst.node(), last = itLast.node();
+    if constexpr (Indexed)
+      Index::cut(guard_, Index::rank(first, guard_), Index::rank(last, guard_));
     first->prev->connectWith(last);
 
     _size -= deleteNodesFrom(first, last);
   }
 
+  /**
+   * @brief moves all elements of 'other' in front of 'position', nodes are
+   *        relinked, not copied, and this list takes over the slabs of
+   *        'other' with them. That takes time linear in the number of slabs
+   *        of the list holding fewer of them, not in its elements.
+   *        Iterators to the moved elements have to be taken from this list
+   *        again.
+   *
+   *        If the allocators of the lists differ, the elements are moved
+   *        one by one, since this list could not free the nodes of 'other'.
+   */
+  void splice(const const_iterator &position, LinkedList &other)
+  {
+    if (this == &other || other._size == 0)
+      return;
+
+    if (_allocator != other._allocator)
+    {
+      for (auto &item : other)
+        insert(position, std::move(item));
+      other.clear();
+      return;
+    }
+
+    // the slabs of one pool are told their new owner, so the larger
+    // pool stays and goes on with the list keeping the elements
+    if (_pool->slabCount() < other._pool->slabCount())
+      std::swap(_pool, other._pool);
+    _pool->absorb(*other._pool);
+    Node *first = other.guard_->next, *last = other.guard_->prev;
+    Node *right = iterator(position).node();
+    if constexpr (Indexed)
+      Index::paste(guard_, Index::cut(other.guard_, 0, other._size), Index::rank(right, guard_));
+    other.guard_->connectWith(other.guard_);
+    linkBefore(right, first, last);
+
+    countTransfer(other, other._size * sizeof(Node));
+    _size += other._size;
+    other._size = 0;
+  }
+
+  /**
+   * @brief moves [first, last) of 'other' in front of 'position', which must
+   *        not lie inside the range. Nodes are relinked, not copied, so
+   *        pointers and references to the elements stay valid. That takes
+   *        O(log n) for indexed lists. Otherwise it takes O(1) within one
+   *        list, and between lists time linear in the range, which is
+   *        walked to count it.
+   *
+   *        The nodes keep their memory in the slabs of 'other', which stay
+   *        allocated until both lists are done with them, see NodePool.
+   *        The whole of 'other' goes over with its slabs, see splice() above.
+   */
+  void splice(const const_iterator &position, LinkedList &other,
+              const const_iterator &first, const const_iterator &last)
+  {
+    if (first == last)
+      return;
+
+    Node *firstNode = iterator(first).node(), *end = iterator(last).node();
+    Node *lastNode = end->prev;
+    Node *right = iterator(position).node();
+
+    if (this != &other)
+    {
+      if (first == other.cbegin() && last == other.cend())
+        return splice(position, other);
+
+      if (_allocator != other._allocator)
+      {
+        for (auto it = iterator(first); it != last; ++it)
+          insert(position, std::move(*it));
+        other.erase(first, last);
+        return;
+      }
+
+      size_type count = 0;
+      if constexpr (Indexed)
+      {
+        size_type from = Index::rank(firstNode, other.guard_), to = Index::rank(end, other.guard_);
+        Index::paste(guard_, Index::cut(other.guard_, from, to), Index::rank(right, guard_));
+        count = to - from;
+      }
+      else
+      {
+        for (Node *node = firstNode; node != end; node = node->next)
+          ++count;
+      }
+      firstNode->prev->connectWith(end);
+      linkBefore(right, firstNode, lastNode);
+
+      other._pool->markLent();
+      _pool->markBorrowed();
+      countTransfer(other, count * sizeof(Node));
+      _size += count;
+      other._size -= count;
+      return;
+    }
+
+    if constexpr (Indexed)
+    {
+      // the position is ranked only once the range is out of the way
+      auto moved = Index::cut(guard_, Index::rank(firstNode, guard_), Index::rank(end, guard_));
+      Index::paste(guard_, moved, Index::rank(right, guard_));
+    }
+    firstNode->prev->connectWith(end);
+    linkBefore(right, firstNode, lastNode);
+  }
+
+  /**
+   * @brief appends all elements of 'other' in O(1), see splice()
+   */
+  void concat(LinkedList &other)
+  {
+    splice(cend(), other);
+  }
+
+  /**
+   * @brief moves [position, end) into a new list by relinking the nodes,
+   *        see splice(): O(log n) for indexed lists, otherwise linear in
+   *        the tail. Splitting at begin() hands the slabs over along with
+   *        the nodes, otherwise the lists share them.
+   */
+  LinkedList splitAt(const const_iterator &position)
+  {
+    LinkedList tail(getAllocator());
+    tail.splice(tail.cend(), *this, position, cend());
+    return tail;
+  }
+
+  /**
+   * @brief stable bottom-up merge sort. Runs of 1, 2, 4... elements are
+   *        merged pairwise by relinking nodes, so no element is copied,
+   *        moved or allocated: O(n log n) time, O(1) extra memory.
+   */
+  template <typename Compare = std::less<Type>>
+  void sort(Compare compare = Compare())
+  {
+    for (size_type width = 1; width < _size; width *= 2)
+    {
+      Node *first = guard_->next;
+      while (first != guard_)
+      {
+        Node *middle = advance(first, width);
+        Node *end = advance(middle, width);
+        mergeAdjacent(first, middle, end, compare);
+        first = end;
+      }
+    }
+
+    rebuildIndex();
+  }
+
+  /**
+   * @brief merges sorted 'other' into this sorted list in linear time,
+   *        leaving 'other' empty. Nodes are taken over as in splice(),
+   *        equal elements of this list stay in front of those of 'other'.
+   */
+  template <typename Compare = std::less<Type>>
+  void merge(LinkedList &other, Compare compare = Compare())
+  {
+    if (this == &other || other._size == 0)
+      return;
+
+    Node *lastOwn = guard_->prev;
+    splice(cend(), other);
+    mergeAdjacent(guard_->next, lastOwn->next, guard_, compare);
+    rebuildIndex();
+  }
+
+  /**
+   * @brief nodes walk() loads ahead of the one being visited
+   */
+  static constexpr size_type defaultPrefetchDistance = 8;
+
+  /**
+   * @brief calls 'fn' with every element in order. Unlike a loop over
+   *        iterators it does no end checks per step and prefetches the
+   *        node 'Distance' nodes ahead, 0 turns prefetching off.
+   */
+  template <size_type Distance = defaultPrefetchDistance, typename Fn>
+  void forEach(Fn fn)
+  {
+    walk<Distance>([&fn](Node *node) {
+      fn(node->elem);
+      return false;
+    });
+  }
+
+  template <size_type Distance = defaultPrefetchDistance, typename Fn>
+  void forEach(Fn fn) const
+  {
+    walk<Distance>([&fn](const Node *node) {
+      fn(static_cast<const Type &>(node->elem));
+      return false;
+    });
+  }
+
+  /**
+   * @brief first element satisfying 'predicate', or end(), see forEach()
+   */
+  template <size_type Distance = defaultPrefetchDistance, typename Predicate>
+  iterator findIf(Predicate predicate)
+  {
+    return iterator(walk<Distance>([&predicate](Node *node) { return predicate(node->elem); }), guard_);
+  }
+
+  template <size_type Distance = defaultPrefetchDistance, typename Predicate>
+  const_iterator findIf(Predicate predicate) const
+  {
+    return const_iterator(walk<Distance>([&predicate](const Node *node) {
+                            return predicate(static_cast<const Type &>(node->elem));
+                          }),
+                          guard_);
+  }
+
+  template <size_type Distance = defaultPrefetchDistance>
+  iterator find(const Type &value)
+  {
+    return findIf<Distance>([&value](const Type &item) { return item == value; });
+  }
+
+  template <size_type Distance = defaultPrefetchDistance>
+  const_iterator find(const Type &value) const
+  {
+    return findIf<Distance>([&value](const Type &item) { return item == value; });
+  }
+
+  /**
+   * @brief number of elements satisfying 'predicate', see forEach()
+   */
+  template <size_type Distance = defaultPrefetchDistance, typename Predicate>
+  size_type count(Predicate predicate) const
+  {
+    size_type result = 0;
+    forEach<Distance>([&](const Type &item) {
+      if (predicate(item))
+        ++result;
+    });
+    return result;
+  }
+
   iterator begin() { return iterator(guard_->next, guard_); }
   iterator end() { return iterator(guard_, guard_); }
   const_iterator cbegin() const { return ConstIterator(guard_->next, guard_); }
@@ -249,9 +607,216 @@ public:
   const_iterator end() const { return cend(); }
 
 private:
+  using Pool = detail::NodePool<Node, NodeAllocator>;
+
+  // declared first, the constructors allocate the guard with it
+  NodeAllocator _allocator;
+  // all nodes but the guard, which outlives Pool::release(). The pool
+  // belongs to this list alone, held through a pointer so that moving
+  // the list leaves it in place.
+  typename Pool::Handle _pool;
   Node *guard_;
   size_type _size;
 
+  LinkedList(const Allocator &allocator, typename Pool::Handle pool)
+      : _allocator(allocator), _pool(std::move(pool)), guard_(createGuard()), _size(0)
+  {
+  }
+
+  /**
+   * @brief empties the list, its nodes have to be destroyed already
+   */
+  void unlinkAll()
+  {
+    guard_->connectWith(guard_);
+    _size = 0;
+    if constexpr (Indexed)
+      Index::clear(guard_);
+  }
+
+  /**
+   * @brief sets the index up from the list order, for changes too
+   *        many to apply one by one, like sorting
+   */
+  void rebuildIndex()
+  {
+    if constexpr (Indexed)
+      Index::rebuild(guard_, guard_->next, [](typename Index::Links *node) -> typename Index::Links * {
+        return static_cast<Node *>(node)->next;
+      });
+  }
+
+  /**
+   * @brief visits nodes in order until 'visit' returns true, returns that
+   *        node or the guard. A second pointer runs 'Distance' nodes ahead
+   *        and prefetches them, so their loads overlap with the visits.
+   *        That pays off when visiting takes time of its own, a bare scan
+   *        stays bound by the chain of dependent 'next' loads either way.
+   */
+  template <size_type Distance, typename Visit>
+  Node *walk(Visit visit) const
+  {
+    Node *ahead = guard_->next;
+    if constexpr (Distance > 0)
+    {
+      for (size_type i = 0; i < Distance && ahead != guard_; ++i)
+        ahead = ahead->next;
+      detail::prefetch(ahead);
+    }
+
+    for (Node *node = guard_->next; node != guard_; node = node->next)
+    {
+      if constexpr (Distance > 0)
+      {
+        // the load of ahead->next is what the previous prefetch started
+        if (ahead != guard_)
+        {
+          ahead = ahead->next;
+          detail::prefetch(ahead);
+        }
+      }
+
+      if (visit(node))
+        return node;
+    }
+    return guard_;
+  }
+
+  /**
+   * @brief links the chain [first, last] in front of 'right'
+   */
+  static void linkBefore(Node *right, Node *first, Node *last)
+  {
+    right->prev->connectWith(first);
+    last->connectWith(right);
+  }
+
+  /**
+   * @brief node 'steps' nodes after 'node', or the guard if the list ends before
+   */
+  Node *advance(Node *node, size_type steps) const
+  {
+    for (; steps > 0 && node != guard_; --steps)
+      node = node->next;
+    return node;
+  }
+
+  /**
+   * @brief merges the sorted, adjacent chains [first, middle) and
+   *        [middle, end) in place. Runs of the second chain are cut out
+   *        and linked in front of the first greater element of the first
+   *        chain, equal elements keep their order.
+   */
+  template <typename Compare>
+  static void mergeAdjacent(Node *first, Node *middle, Node *end, Compare &compare)
+  {
+    while (first != middle && middle != end)
+    {
+      if (!compare(middle->elem, first->elem))
+      {
+        first = first->next;
+        continue;
+      }
+
+      Node *runLast = middle;
+      while (runLast->next != end && compare(runLast->next->elem, first->elem))
+        runLast = runLast->next;
+
+      Node *next = runLast->next;
+      middle->prev->connectWith(next);
+      linkBefore(first, middle, runLast);
+      middle = next;
+    }
+  }
+
+  template <typename... Args>
+  Node *createNode(Args &&... args)
+  {
+    Node *node = _pool->allocate();
+    try
+    {
+      new (node) Node(std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      _pool->deallocate(node);
+      throw;
+    }
+    countAllocation(sizeof(Node));
+    return node;
+  }
+
+  void destroyNode(Node *node)
+  {
+    node->~Node();
+    _pool->deallocate(node);
+    countFree(sizeof(Node));
+  }
+
+  Node *createGuard()
+  {
+    return createGuard(_allocator);
+  }
+
+  Node *createGuard(NodeAllocator &allocator)
+  {
+    Node *guard = NodeAllocatorTraits::allocate(allocator, 1);
+    new (guard) Node();
+    guard->connectWith(guard);
+    countAllocation(sizeof(Node));
+    return guard;
+  }
+
+  void destroyGuard(Node *guard)
+  {
+    guard->~Node();
+    NodeAllocatorTraits::deallocate(_allocator, guard, 1);
+    countFree(sizeof(Node));
+  }
+
+  /**
+   * @brief destroys every element and releases all slabs at once,
+   *        nodes are not put back on the free list one by one, nor even
+   *        visited when they are trivially destructible. Only if the list
+   *        shares slabs with others every node is freed on its own.
+   */
+  void destroyAllNodes()
+  {
+    if (_pool->isShared())
+    {
+      deleteNodesFrom(guard_->next, guard_);
+      unlinkAll();
+      _pool->release();
+      return;
+    }
+
+    if constexpr (!std::is_trivially_destructible_v<Node>)
+    {
+      for (Node *it = guard_->next; it != guard_;)
+      {
+        Node *next = it->next;
+        it->~Node();
+        it = next;
+      }
+    }
+
+    countFree(_size * sizeof(Node), _size);
+    unlinkAll();
+    _pool->release();
+  }
+
+  template <typename... Args>
+  Type &emplaceBetween(Node *left, Node *right, Args &&... args)
+  {
+    Node *newElem = createNode(std::forward<Args>(args)...);
+    if constexpr (Indexed)
+      Index::insert(guard_, newElem, Index::rank(right, guard_));
+    newElem->insertInBetween(left, right);
+    ++_size;
+
+    return newElem->elem;
+  }
+
   /**
  * @brief this method starts from node 'fromIncluded' and deletes
  *        every node that it encounters. Next elements are selected
@@ -262,14 +827,14 @@ private:
  * @param toExcluded  node that
  * @return int Number of elements deleted
  */
-  static int deleteNodesFrom(Node *fromIncluded, Node *toExcluded)
+  int deleteNodesFrom(Node *fromIncluded, Node *toExcluded)
   {
     int elementsDeleted = 0;
     auto it = fromIncluded;
     while (it && it != toExcluded)
     {
       auto next = it->next;
-      delete it;
+      destroyNode(it);
       elementsDeleted++;
       it = next;
     }
@@ -277,24 +842,27 @@ private:
   }
 
   /**
-   * @brief deletes a node from a list and returns it value
+   * @brief deletes a node from a list and returns it value,
+   *        the value is moved out of the node, not copied
    * 
    * @param nodeToPop 
    * @return value of the deleted node
    */
   Type pop(Node *nodeToPop)
   {
-    auto value = nodeToPop->elem;
+    Type value(std::move(nodeToPop->elem));
 
+    if constexpr (Indexed)
+      Index::erase(guard_, nodeToPop);
     nodeToPop->disconnect();
-    delete nodeToPop;
+    destroyNode(nodeToPop);
 
     return value;
   }
 };
 
-template <typename Type>
-class LinkedList<Type>::ConstIterator
+template <typename Type, typename Allocator, bool Indexed>
+class LinkedList<Type, Allocator, Indexed>::ConstIterator
 {
 public:
   using iterator_category = std::bidirectional_iterator_tag;
@@ -309,7 +877,7 @@ public:
 
   explicit ConstIterator(const Node *item, const Node *guard) : itr(item), guard(guard) {}
 
-  ConstIterator(const ConstIterator &other) : itr(other.itr) {}
+  ConstIterator(const ConstIterator &other) : itr(other.itr), guard(other.guard) {}
 
   reference operator*() const
   {
@@ -363,6 +931,17 @@ public:
 
   ConstIterator operator+(difference_type d) const
   {
+    if constexpr (Indexed)
+    {
+      if (d <= 0)
+        return *this;
+
+      auto index = Index::rank(itr, guard) + static_cast<size_type>(d);
+      if (index > Index::size(guard))
+        throw std::out_of_range("Adding iterator pass the end");
+      return ConstIterator(static_cast<const Node *>(Index::select(const_cast<Node *>(guard), index)), guard);
+    }
+
     auto temp = itr;
     for (int i = 0; i < d; i++)
     {
@@ -377,6 +956,17 @@ public:
 
   ConstIterator operator-(difference_type d) const
   {
+    if constexpr (Indexed)
+    {
+      if (d <= 0)
+        return *this;
+
+      auto index = Index::rank(itr, guard);
+      if (static_cast<size_type>(d) > index)
+        throw std::out_of_range("Substracting iterator pass the begining");
+      return ConstIterator(static_cast<const Node *>(Index::select(const_cast<Node *>(guard), index - d)), guard);
+    }
+
     auto temp = itr;
     for (int i = 0; i < d; i++)
     {
@@ -409,8 +999,8 @@ private:
   const Node *guard;
 };
 
-template <typename Type>
-class LinkedList<Type>::Iterator : public LinkedList<Type>::ConstIterator
+template <typename Type, typename Allocator, bool Indexed>
+class LinkedList<Type, Allocator, Indexed>::Iterator : public LinkedList<Type, Allocator, Indexed>::ConstIterator
 {
 public:
   using pointer = typename LinkedList::pointer;
@@ -473,6 +1063,23 @@ public:
   }
 };
 
+/**
+ * @brief LinkedList with O(log n) access by position
+ */
+template <typename Type, typename Allocator = std::allocator<Type>>
+using IndexedLinkedList = LinkedList<Type, Allocator, true>;
+
+namespace pmr
+{
+
+/**
+ * @brief LinkedList taking its nodes from a std::pmr::memory_resource
+ */
+template <typename Type>
+using LinkedList = aisdi::LinkedList<Type, std::pmr::polymorphic_allocator<Type>>;
+
+} // namespace pmr
+
 } // namespace aisdi
 
 #endif // AISDI_LINEAR_LINKEDLIST_H
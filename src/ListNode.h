@@ -0,0 +1,84 @@
+#ifndef AISDI_LINEAR_LISTNODE_H
+#define AISDI_LINEAR_LISTNODE_H
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+/**
+ * @brief links of a node in a circular doubly linked list with a guard,
+ *        'Derived' is the node type, so that the links point at whole nodes
+ */
+template <typename Derived>
+struct ListNode
+{
+  /**
+   * @brief inserts itself between two other nodes, assumes that
+   *        other nodes are connected
+   *
+   *             ----                        ->  ----  <----
+   *            |this|                       |  |this|-     |
+   *             ----                        |   ----  |    |
+   *                                         |  |      |    |
+   *                                         |  |      |    |
+   *                                         |  \/     \/   |
+   *        ----   --->  -----              ----         -----
+   *       |left|       |right|   =====>   |left|       |right|
+   *        ----   <---  -----              ----         -----
+   *
+   * @param left
+   * @param right
+   */
+  void insertInBetween(Derived *left, Derived *right)
+  {
+    left->next = self();
+    this->prev = left;
+
+    right->prev = self();
+    this->next = right;
+  }
+
+  void connectWith(Derived *other)
+  {
+    next = other;
+    other->prev = self();
+  }
+
+  /**
+   * @brief disconnects itself from two other nodes, prev and next
+   *  ->  ----  <----                          ----
+   *  |  |this|-     |                        |this|
+   *  |   ----  |    |                         ----
+   *  |  |      |    |
+   *  |  |      |    |        =======>
+   *  |  \/     \/   |                    -----   --->  -----
+   *  ----         -----                  |left|       |right|
+   *  |left|       |right|                -----   <---  -----
+   *  ----         -----
+   *
+   */
+  void disconnect()
+  {
+    auto left = prev, right = next;
+    prev = nullptr;
+    next = nullptr;
+    if (left)
+      left->connectWith(right);
+    else if (right)
+      right->connectWith(left);
+  }
+
+  Derived *next = nullptr;
+  Derived *prev = nullptr;
+
+private:
+  Derived *self() { return static_cast<Derived *>(this); }
+};
+
+} // namespace detail
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_LISTNODE_H
@@ -0,0 +1,340 @@
+#ifndef AISDI_LINEAR_LOCKFREEQUEUE_H
+#define AISDI_LINEAR_LOCKFREEQUEUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+// fields written by different threads are kept this far apart
+constexpr std::size_t cacheLineSize = 64;
+
+/**
+ * @brief node of a lock-free queue. As in LinkedList a sentinel node is
+ *        always present, here it is the node whose value was consumed last,
+ *        so its storage holds no value.
+ */
+template <typename Type>
+struct QueueNode
+{
+  std::atomic<QueueNode *> next{nullptr};
+  alignas(Type) unsigned char storage[sizeof(Type)];
+
+  Type &value() { return *reinterpret_cast<Type *>(storage); }
+};
+
+/**
+ * @brief allocation of queue nodes, shared by both queues
+ */
+template <typename Type, typename Allocator>
+class QueueNodes
+{
+public:
+  using Node = QueueNode<Type>;
+
+  explicit QueueNodes(const Allocator &allocator) : _allocator(allocator) {}
+
+  Node *allocate()
+  {
+    Node *node = NodeAllocatorTraits::allocate(_allocator, 1);
+    return new (node) Node();
+  }
+
+  void deallocate(Node *node)
+  {
+    node->~Node();
+    NodeAllocatorTraits::deallocate(_allocator, node, 1);
+  }
+
+  /**
+   * @brief frees the chain starting at 'node', values must be gone already
+   */
+  void deallocateChain(Node *node)
+  {
+    while (node)
+    {
+      Node *next = node->next.load(std::memory_order_relaxed);
+      deallocate(node);
+      node = next;
+    }
+  }
+
+  template <typename... Args>
+  static void construct(Node *node, Args &&... args)
+  {
+    new (node->storage) Type(std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief moves the value out of 'node' into 'out' and destroys it
+   */
+  static void take(Node *node, Type &out)
+  {
+    out = std::move(node->value());
+    node->value().~Type();
+  }
+
+  /**
+   * @brief destroys the values of the nodes after 'sentinel'
+   */
+  static void destroyValuesAfter(Node *sentinel)
+  {
+    for (Node *node = sentinel->next.load(std::memory_order_acquire); node;
+         node = node->next.load(std::memory_order_acquire))
+      node->value().~Type();
+  }
+
+private:
+  using NodeAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Node>;
+  using NodeAllocatorTraits = std::allocator_traits<NodeAllocator>;
+
+  NodeAllocator _allocator;
+};
+
+} // namespace detail
+
+/**
+ * @brief unbounded lock-free queue for exactly one producer thread, calling
+ *        push() and emplace(), and one consumer thread, calling tryPop() and
+ *        isEmpty(). Both sides are wait-free apart from the allocator.
+ *
+ *        Consumed nodes stay linked in front of the sentinel, the producer
+ *        reuses them from there, so a queue whose length stays bounded stops
+ *        allocating once it has grown to that length.
+ */
+template <typename Type, typename Allocator = std::allocator<Type>>
+class SpscQueue
+{
+  using Nodes = detail::QueueNodes<Type, Allocator>;
+  using Node = typename Nodes::Node;
+
+public:
+  using value_type = Type;
+  using size_type = std::size_t;
+
+  SpscQueue() : SpscQueue(Allocator()) {}
+  explicit SpscQueue(const Allocator &allocator) : _nodes(allocator)
+  {
+    Node *sentinel = _nodes.allocate();
+    _last = sentinel;
+    _firstFree = sentinel;
+    _sentinelCopy = sentinel;
+    _sentinel.store(sentinel, std::memory_order_relaxed);
+  }
+  SpscQueue(const SpscQueue &) = delete;
+  ~SpscQueue()
+  {
+    Nodes::destroyValuesAfter(_sentinel.load(std::memory_order_acquire));
+    _nodes.deallocateChain(_firstFree);
+  }
+
+  SpscQueue &operator=(const SpscQueue &) = delete;
+
+  void push(const Type &item) { emplace(item); }
+  void push(Type &&item) { emplace(std::move(item)); }
+
+  template <typename... Args>
+  void emplace(Args &&... args)
+  {
+    Node *node = takeFreeNode();
+    try
+    {
+      Nodes::construct(node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      _nodes.deallocate(node);
+      throw;
+    }
+
+    _last->next.store(node, std::memory_order_release);
+    _last = node;
+  }
+
+  /**
+   * @brief moves the oldest item into 'out', false if there is none
+   */
+  bool tryPop(Type &out)
+  {
+    Node *sentinel = _sentinel.load(std::memory_order_relaxed);
+    Node *next = sentinel->next.load(std::memory_order_acquire);
+    if (!next)
+      return false;
+
+    Nodes::take(next, out);
+    // hands the old sentinel over to the producer
+    _sentinel.store(next, std::memory_order_release);
+    return true;
+  }
+
+  bool isEmpty() const
+  {
+    return _sentinel.load(std::memory_order_relaxed)->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  // consumer side
+  alignas(detail::cacheLineSize) std::atomic<Node *> _sentinel;
+
+  // producer side: the newest node, the oldest consumed one and
+  // the sentinel as last seen, nodes in [_firstFree, _sentinelCopy)
+  // can be reused without looking at the consumer again
+  alignas(detail::cacheLineSize) Node *_last;
+  Node *_firstFree;
+  Node *_sentinelCopy;
+  Nodes _nodes;
+
+  Node *takeFreeNode()
+  {
+    if (_firstFree == _sentinelCopy)
+    {
+      _sentinelCopy = _sentinel.load(std::memory_order_acquire);
+      if (_firstFree == _sentinelCopy)
+        return _nodes.allocate();
+    }
+
+    Node *node = _firstFree;
+    _firstFree = node->next.load(std::memory_order_relaxed);
+    node->next.store(nullptr, std::memory_order_relaxed);
+    return node;
+  }
+};
+
+/**
+ * @brief unbounded lock-free queue for any number of producer threads and
+ *        one consumer thread, after Dmitry Vyukov's MPSC queue. A push is
+ *        one atomic exchange and wait-free, a pop is wait-free too.
+ *
+ *        A producer preempted between its exchange and linking its node
+ *        hides the nodes pushed after it until it resumes, tryPop() reports
+ *        the queue as empty meanwhile.
+ *
+ *        Consumed nodes are recycled: the consumer collects them and
+ *        publishes the batch once the shared free stack is empty, producers
+ *        take the whole stack with an exchange, so no node is ever popped by
+ *        compare-and-swap and the stack is free of the ABA problem.
+ */
+template <typename Type, typename Allocator = std::allocator<Type>>
+class MpscQueue
+{
+  using Nodes = detail::QueueNodes<Type, Allocator>;
+  using Node = typename Nodes::Node;
+
+public:
+  using value_type = Type;
+  using size_type = std::size_t;
+
+  MpscQueue() : MpscQueue(Allocator()) {}
+  explicit MpscQueue(const Allocator &allocator) : _nodes(allocator)
+  {
+    Node *sentinel = _nodes.allocate();
+    _sentinel = sentinel;
+    _spare = nullptr;
+    _last.store(sentinel, std::memory_order_relaxed);
+    _free.store(nullptr, std::memory_order_relaxed);
+  }
+  MpscQueue(const MpscQueue &) = delete;
+  ~MpscQueue()
+  {
+    Nodes::destroyValuesAfter(_sentinel);
+    _nodes.deallocateChain(_sentinel);
+    _nodes.deallocateChain(_spare);
+    _nodes.deallocateChain(_free.load(std::memory_order_acquire));
+  }
+
+  MpscQueue &operator=(const MpscQueue &) = delete;
+
+  void push(const Type &item) { emplace(item); }
+  void push(Type &&item) { emplace(std::move(item)); }
+
+  template <typename... Args>
+  void emplace(Args &&... args)
+  {
+    Node *node = takeFreeNode();
+    try
+    {
+      Nodes::construct(node, std::forward<Args>(args)...);
+    }
+    catch (...)
+    {
+      _nodes.deallocate(node);
+      throw;
+    }
+
+    Node *previous = _last.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+  }
+
+  /**
+   * @brief moves the oldest item into 'out', false if there is none,
+   *        only the consumer thread may call it
+   */
+  bool tryPop(Type &out)
+  {
+    Node *next = _sentinel->next.load(std::memory_order_acquire);
+    if (!next)
+      return false;
+
+    Nodes::take(next, out);
+    recycle(_sentinel);
+    _sentinel = next;
+    return true;
+  }
+
+  bool isEmpty() const
+  {
+    return _sentinel->next.load(std::memory_order_acquire) == nullptr;
+  }
+
+private:
+  // producer side
+  alignas(detail::cacheLineSize) std::atomic<Node *> _last;
+  alignas(detail::cacheLineSize) std::atomic<Node *> _free;
+
+  // consumer side, _spare collects consumed nodes until _free is empty
+  alignas(detail::cacheLineSize) Node *_sentinel;
+  Node *_spare;
+  Nodes _nodes;
+
+  void recycle(Node *node)
+  {
+    node->next.store(_spare, std::memory_order_relaxed);
+    _spare = node;
+
+    Node *expected = nullptr;
+    if (_free.load(std::memory_order_relaxed) == nullptr &&
+        _free.compare_exchange_strong(expected, _spare, std::memory_order_release, std::memory_order_relaxed))
+      _spare = nullptr;
+  }
+
+  Node *takeFreeNode()
+  {
+    Node *node = _free.exchange(nullptr, std::memory_order_acquire);
+    if (!node)
+      return _nodes.allocate();
+
+    // the rest goes back unless the consumer published a new batch
+    // meanwhile, then it is freed, as chains cannot be joined in O(1)
+    Node *rest = node->next.load(std::memory_order_relaxed);
+    if (rest)
+    {
+      Node *expected = nullptr;
+      if (!_free.compare_exchange_strong(expected, rest, std::memory_order_release, std::memory_order_relaxed))
+        _nodes.deallocateChain(rest);
+    }
+
+    node->next.store(nullptr, std::memory_order_relaxed);
+    return node;
+  }
+};
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_LOCKFREEQUEUE_H
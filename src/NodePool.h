@@ -0,0 +1,436 @@
+#ifndef AISDI_LINEAR_NODEPOOL_H
+#define AISDI_LINEAR_NODEPOOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+/**
+ * @brief hands out memory for single nodes of a linked list.
+ *
+ *        Nodes are cut out of slabs whose size doubles up to
+ *        maxSlabNodes, so a list makes a logarithmic number of calls to
+ *        the allocator instead of one per node. Freed nodes go onto a free
+ *        list and are reused before the current slab is touched again.
+ *        reserve() sizes a slab up front, so that nodes allocated one after
+ *        another lie next to each other, in one block of memory.
+ *
+ *        Every pool belongs to a single list and only that list allocates
+ *        from it. Nodes moving to another list stay where they are, so
+ *        slabs can hold nodes of several lists: a list freeing a node of
+ *        a slab its pool does not own only counts it as returned, and the
+ *        slab goes back to the allocator once its pool let go of it and
+ *        every node lent out has been returned. Those counts are atomic,
+ *        so the lists may be used from different threads.
+ *
+ *        Slabs are made of blocks aligned to their size, each starting with
+ *        a pointer to the slab header, which is how a node finds its slab.
+ *
+ *        The pool deals in raw memory, it never constructs or destroys nodes.
+ */
+template <typename Node, typename Allocator>
+class NodePool
+{
+  union Slot
+  {
+    Slot *nextFree;
+    alignas(Node) unsigned char storage[sizeof(Node)];
+  };
+
+  struct SlabHeader;
+
+  // lives in the first slot of every block
+  struct BlockHeader
+  {
+    SlabHeader *slab;
+  };
+
+  // lives at the start of the first block of every slab
+  struct SlabHeader
+  {
+    SlabHeader(NodePool *owner, std::size_t blocks_)
+        : block{this}, next(nullptr), blocks(blocks_), used(0), pool(owner), returned(0), outstanding(0), free(0)
+    {
+    }
+
+    BlockHeader block;
+    SlabHeader *next;
+    std::size_t blocks;
+    // slots cut out of the slab, set once it stops being the one cut from
+    std::size_t used;
+    // the pool cutting nodes from the slab, nullptr once it let go of it
+    std::atomic<NodePool *> pool;
+    // nodes freed by lists of other pools, 'orphaned' is added once the
+    // pool let go of the slab with 'outstanding' nodes in other lists
+    std::atomic<std::size_t> returned;
+    std::size_t outstanding;
+    // free slots, counted by release()
+    std::size_t free;
+  };
+
+  static constexpr std::size_t roundUpToPowerOfTwo(std::size_t value)
+  {
+    std::size_t power = 1;
+    while (power < value)
+      power *= 2;
+    return power;
+  }
+
+public:
+  static constexpr std::size_t minSlabNodes = 8;
+  static constexpr std::size_t maxSlabNodes = 1024;
+
+private:
+  static constexpr std::size_t headerSlots = (sizeof(SlabHeader) + sizeof(Slot) - 1) / sizeof(Slot);
+  static constexpr std::size_t blockBytes = roundUpToPowerOfTwo((headerSlots + minSlabNodes) * sizeof(Slot));
+  static constexpr std::size_t slotsPerBlock = blockBytes / sizeof(Slot);
+  static constexpr std::size_t orphaned = ~(~std::size_t(0) >> 1);
+
+  static_assert(sizeof(BlockHeader) <= sizeof(Slot), "Block header has to fit into a slot");
+
+  struct alignas(blockBytes) Block
+  {
+    unsigned char bytes[blockBytes];
+  };
+
+  using BlockAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Block>;
+  using BlockAllocatorTraits = std::allocator_traits<BlockAllocator>;
+
+public:
+  /**
+   * @brief frees the pool with the allocator it was made with
+   */
+  struct Deleter
+  {
+    void operator()(NodePool *pool) const
+    {
+      using PoolAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<NodePool>;
+      PoolAllocator allocator(pool->_allocator);
+      pool->~NodePool();
+      std::allocator_traits<PoolAllocator>::deallocate(allocator, pool, 1);
+    }
+  };
+
+  using Handle = std::unique_ptr<NodePool, Deleter>;
+
+  /**
+   * @brief makes a pool in memory from 'allocator', lists keep theirs
+   *        through a pointer, as slabs refer to it by its address
+   */
+  static Handle create(const Allocator &allocator)
+  {
+    using PoolAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<NodePool>;
+    PoolAllocator poolAllocator(allocator);
+    NodePool *pool = std::allocator_traits<PoolAllocator>::allocate(poolAllocator, 1);
+    return Handle(new (pool) NodePool(allocator));
+  }
+
+  explicit NodePool(const Allocator &allocator)
+      : _allocator(allocator), _slabs(nullptr), _slabCount(0), _freeList(nullptr), _lastFree(nullptr),
+        _bumpSlab(nullptr), _bumpNext(nullptr), _bumpLeft(0), _nextSlabNodes(minSlabNodes), _lent(false),
+        _borrowed(false)
+  {
+  }
+  NodePool(const NodePool &) = delete;
+  ~NodePool()
+  {
+    release();
+  }
+
+  NodePool &operator=(const NodePool &) = delete;
+
+  std::size_t slabCount() const { return _slabCount; }
+
+  /**
+   * @brief takes over all slabs and free nodes of 'other', leaving it
+   *        empty, in time linear in the number of slabs of 'other'.
+   *        Allocators of the pools have to compare equal, as this one
+   *        frees the slabs of 'other' from then on.
+   */
+  void absorb(NodePool &other)
+  {
+    SlabHeader *last = nullptr;
+    for (SlabHeader *slab = other._slabs; slab; slab = slab->next)
+    {
+      slab->pool.store(this, std::memory_order_relaxed);
+      last = slab;
+    }
+    if (last)
+    {
+      last->next = _slabs;
+      _slabs = other._slabs;
+      _slabCount += other._slabCount;
+    }
+
+    if (other._freeList)
+    {
+      other._lastFree->nextFree = _freeList;
+      if (!_freeList)
+        _lastFree = other._lastFree;
+      _freeList = other._freeList;
+    }
+
+    // only one unused slab tail can be cut from, the other one
+    // stays allocated until the slabs are released
+    other.retireBumpSlab();
+    takeBumpIfLarger(other);
+    _nextSlabNodes = std::max(_nextSlabNodes, other._nextSlabNodes);
+    _lent = _lent || other._lent;
+    _borrowed = _borrowed || other._borrowed;
+
+    other.forget();
+  }
+
+  /**
+   * @brief records that nodes of this pool went to a list of another pool
+   */
+  void markLent() { _lent = true; }
+
+  /**
+   * @brief records that the list took nodes of another pool
+   */
+  void markBorrowed() { _borrowed = true; }
+
+  /**
+   * @brief whether nodes of the list and of the pool may be apart, then
+   *        every node has to be freed one by one before release()
+   */
+  bool isShared() const { return _lent || _borrowed; }
+
+  /**
+   * @brief makes sure that the next 'count' nodes not taken from the free
+   *        list come from one slab, allocating it if the current one is
+   *        too small. The rest of the current slab stays unused until the
+   *        slabs are released.
+   */
+  void reserve(std::size_t count)
+  {
+    if (_bumpLeft < count)
+      addSlab(std::max(count, _nextSlabNodes));
+  }
+
+  Node *allocate()
+  {
+    Slot *slot;
+    if (_freeList)
+    {
+      slot = _freeList;
+      _freeList = slot->nextFree;
+      if (!_freeList)
+        _lastFree = nullptr;
+    }
+    else
+    {
+      if (_bumpLeft == 0)
+        addSlab(_nextSlabNodes);
+      slot = _bumpNext;
+      if (--_bumpLeft > 0)
+        _bumpNext = following(slot);
+    }
+
+    return reinterpret_cast<Node *>(slot);
+  }
+
+  /**
+   * @brief takes 'node' back for reuse, or only counts it as returned
+   *        if it comes from a slab of another pool
+   */
+  void deallocate(Node *node)
+  {
+    Slot *slot = reinterpret_cast<Slot *>(node);
+    if (_borrowed)
+    {
+      SlabHeader *slab = slabOf(slot);
+      if (slab->pool.load(std::memory_order_relaxed) != this)
+        return giveBack(slab);
+    }
+
+    slot->nextFree = _freeList;
+    _freeList = slot;
+    if (!_lastFree)
+      _lastFree = slot;
+  }
+
+  /**
+   * @brief gives every slab back to the allocator, all nodes of the list
+   *        have to be destroyed already, and if isShared() freed as well.
+   *        Slabs with nodes still in other lists are left to the last
+   *        of them to be freed.
+   */
+  void release()
+  {
+    if (_lent)
+    {
+      for (Slot *slot = _freeList; slot; slot = slot->nextFree)
+        ++slabOf(slot)->free;
+    }
+
+    retireBumpSlab();
+    while (_slabs)
+    {
+      SlabHeader *slab = _slabs;
+      _slabs = slab->next;
+
+      std::size_t outstanding = _lent ? slab->used - slab->free : 0;
+      if (outstanding == 0)
+        freeSlab(slab);
+      else
+        orphan(slab, outstanding);
+    }
+
+    forget();
+  }
+
+private:
+  BlockAllocator _allocator;
+  SlabHeader *_slabs;
+  std::size_t _slabCount;
+  // the oldest free slot is tracked so that absorbing is O(1) in free nodes
+  Slot *_freeList;
+  Slot *_lastFree;
+
+  // unused part of the slab nodes are cut from
+  SlabHeader *_bumpSlab;
+  Slot *_bumpNext;
+  std::size_t _bumpLeft;
+  std::size_t _nextSlabNodes;
+
+  bool _lent;
+  bool _borrowed;
+
+  static SlabHeader *slabOf(const void *slot)
+  {
+    auto block = reinterpret_cast<std::uintptr_t>(slot) & ~(blockBytes - 1);
+    return reinterpret_cast<const BlockHeader *>(block)->slab;
+  }
+
+  /**
+   * @brief the slot after 'slot', past the header of the next block
+   */
+  static Slot *following(Slot *slot)
+  {
+    auto next = reinterpret_cast<std::uintptr_t>(slot + 1);
+    auto offset = next & (blockBytes - 1);
+    if (offset != 0 && offset + sizeof(Slot) <= blockBytes)
+      return slot + 1;
+
+    auto block = (next + blockBytes - 1) & ~(blockBytes - 1);
+    return reinterpret_cast<Slot *>(block) + 1;
+  }
+
+  static std::size_t capacity(std::size_t blocks)
+  {
+    return blocks * (slotsPerBlock - 1) - (headerSlots - 1);
+  }
+
+  std::size_t used(SlabHeader *slab) const
+  {
+    if (slab == _bumpSlab)
+      return capacity(slab->blocks) - _bumpLeft;
+    return slab->used;
+  }
+
+  /**
+   * @brief records how much of the slab nodes are cut from was used,
+   *        before another one takes its place
+   */
+  void retireBumpSlab()
+  {
+    if (_bumpSlab)
+      _bumpSlab->used = used(_bumpSlab);
+  }
+
+  /**
+   * @brief cuts nodes from the unused slab tail of 'other' from now on if
+   *        it is longer than the own one, the shorter tail stays unused
+   */
+  void takeBumpIfLarger(NodePool &other)
+  {
+    if (other._bumpLeft <= _bumpLeft)
+      return;
+
+    retireBumpSlab();
+    _bumpSlab = other._bumpSlab;
+    _bumpNext = other._bumpNext;
+    _bumpLeft = other._bumpLeft;
+  }
+
+  void addSlab(std::size_t nodes)
+  {
+    std::size_t blocks = std::max<std::size_t>(1, (nodes + headerSlots + slotsPerBlock - 3) / (slotsPerBlock - 1));
+    Block *memory = BlockAllocatorTraits::allocate(_allocator, blocks);
+    SlabHeader *slab = new (memory) SlabHeader(this, blocks);
+    for (std::size_t i = 1; i < blocks; ++i)
+      new (memory + i) BlockHeader{slab};
+
+    retireBumpSlab();
+    slab->next = _slabs;
+    _slabs = slab;
+    ++_slabCount;
+    _bumpSlab = slab;
+    _bumpNext = reinterpret_cast<Slot *>(memory) + headerSlots;
+    _bumpLeft = capacity(blocks);
+
+    if (_nextSlabNodes < maxSlabNodes)
+      _nextSlabNodes *= 2;
+  }
+
+  void freeSlab(SlabHeader *slab)
+  {
+    std::size_t blocks = slab->blocks;
+    BlockAllocatorTraits::deallocate(_allocator, reinterpret_cast<Block *>(slab), blocks);
+  }
+
+  /**
+   * @brief lets go of a slab with 'outstanding' nodes in other lists,
+   *        it is freed here if they have all been returned already
+   */
+  void orphan(SlabHeader *slab, std::size_t outstanding)
+  {
+    slab->outstanding = outstanding;
+    slab->pool.store(nullptr, std::memory_order_relaxed);
+    if (slab->returned.fetch_or(orphaned, std::memory_order_acq_rel) == outstanding)
+      freeSlab(slab);
+  }
+
+  /**
+   * @brief counts a node of another pool as returned, the last one
+   *        returned to an orphaned slab frees it
+   */
+  void giveBack(SlabHeader *slab)
+  {
+    std::size_t returned = slab->returned.fetch_add(1, std::memory_order_acq_rel) + 1;
+    if ((returned & orphaned) && (returned & ~orphaned) == slab->outstanding)
+      freeSlab(slab);
+  }
+
+  void forget()
+  {
+    _slabs = nullptr;
+    _slabCount = 0;
+    _freeList = nullptr;
+    _lastFree = nullptr;
+    _bumpSlab = nullptr;
+    _bumpNext = nullptr;
+    _bumpLeft = 0;
+    _nextSlabNodes = minSlabNodes;
+    _lent = false;
+    _borrowed = false;
+  }
+};
+
+} // namespace detail
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_NODEPOOL_H
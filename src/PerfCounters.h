@@ -0,0 +1,230 @@
+#ifndef AISDI_LINEAR_PERFCOUNTERS_H
+#define AISDI_LINEAR_PERFCOUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#  include <cerrno>
+#  include <linux/perf_event.h>
+#  include <sys/ioctl.h>
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+#include "Benchmark.h"
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+/**
+ * @brief hardware counters of the timed code, read through Linux
+ *        perf_event_open: cycles, instructions, L1 data and last level cache
+ *        misses, branch misses and data TLB misses, reported per operation
+ *        together with instructions per cycle.
+ *
+ *        Counters the machine or the kernel does not offer are left out.
+ *        Only user space is counted, threads started inside the timed code
+ *        included once they are joined. When the kernel multiplexes more
+ *        counters than there are registers, values are scaled up by the
+ *        share of time each one actually ran.
+ */
+class PerfCounters : public Probe
+{
+public:
+  /**
+   * @brief opens every counter it can, nullptr if none, then 'error' says
+   *        why (no permission, no PMU in a container or VM, not Linux)
+   */
+  static std::unique_ptr<PerfCounters> open(std::string &error)
+  {
+    std::unique_ptr<PerfCounters> counters(new PerfCounters());
+#if defined(__linux__)
+    for (const auto &kind : kinds())
+    {
+      int fd = openCounter(kind.type, kind.config);
+      if (fd >= 0)
+        counters->_events.push_back({kind.name, fd, {}, false, 0});
+      else if (error.empty())
+        error = std::string("perf_event_open: ") + std::strerror(errno);
+    }
+#else
+    error = "hardware counters are read through perf_event_open, Linux only";
+#endif
+    if (counters->_events.empty())
+      return nullptr;
+
+    error.clear();
+    return counters;
+  }
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  ~PerfCounters() override
+  {
+#if defined(__linux__)
+    for (auto &event : _events)
+      close(event.fd);
+#endif
+  }
+
+  /**
+   * @brief names of the counters that could be opened
+   */
+  std::vector<std::string> names() const
+  {
+    std::vector<std::string> names;
+    for (const auto &event : _events)
+      names.push_back(event.name);
+    return names;
+  }
+
+  void reset() override
+  {
+    for (auto &event : _events)
+      event.total = 0;
+  }
+
+  /**
+   * @brief takes the readings the ones in stop() are compared with,
+   *        PERF_EVENT_IOC_RESET would only clear the values, not the times
+   *        multiplexing is scaled by
+   */
+  void start() override
+  {
+#if defined(__linux__)
+    for (auto &event : _events)
+      event.started = readCounter(event.fd, event.atStart);
+    for (auto &event : _events)
+      ioctl(event.fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+
+  void stop() override
+  {
+#if defined(__linux__)
+    for (auto &event : _events)
+      ioctl(event.fd, PERF_EVENT_IOC_DISABLE, 0);
+
+    for (auto &event : _events)
+    {
+      Reading atStop;
+      if (!event.started || !readCounter(event.fd, atStop))
+        continue;
+
+      // only this region, scaled by the share of it the counter ran
+      const double value = static_cast<double>(atStop.value - event.atStart.value);
+      const std::uint64_t enabled = atStop.enabled - event.atStart.enabled;
+      const std::uint64_t running = atStop.running - event.atStart.running;
+      if (running == 0)
+        continue;
+
+      event.total += running < enabled ? value * static_cast<double>(enabled) / static_cast<double>(running) : value;
+    }
+#endif
+  }
+
+  void report(State &state) override
+  {
+    const double operations = state.operations() ? static_cast<double>(state.operations()) : 1.0;
+    const Event *cycles = find("cycles");
+    const Event *instructions = find("instructions");
+
+    for (const auto &event : _events)
+      state.setCounter(std::string(event.name) + "/op", event.total / operations);
+    if (cycles && instructions && cycles->total > 0)
+      state.setCounter("IPC", instructions->total / cycles->total);
+  }
+
+private:
+  // laid out as read() returns it for the read_format set in openCounter()
+  struct Reading
+  {
+    std::uint64_t value;
+    std::uint64_t enabled;
+    std::uint64_t running;
+  };
+
+  struct Event
+  {
+    const char *name;
+    int fd;
+    Reading atStart;
+    bool started;
+    double total;
+  };
+
+  std::vector<Event> _events;
+
+  PerfCounters() = default;
+
+  const Event *find(const char *name) const
+  {
+    for (const auto &event : _events)
+      if (std::strcmp(event.name, name) == 0)
+        return &event;
+    return nullptr;
+  }
+
+#if defined(__linux__)
+  struct Kind
+  {
+    const char *name;
+    std::uint32_t type;
+    std::uint64_t config;
+  };
+
+  static constexpr std::uint64_t cacheMiss(std::uint64_t cache)
+  {
+    return cache | (std::uint64_t{PERF_COUNT_HW_CACHE_OP_READ} << 8) |
+           (std::uint64_t{PERF_COUNT_HW_CACHE_RESULT_MISS} << 16);
+  }
+
+  static std::vector<Kind> kinds()
+  {
+    return {
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"L1d-misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_L1D)},
+        {"LLC-misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_LL)},
+        {"branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"dTLB-misses", PERF_TYPE_HW_CACHE, cacheMiss(PERF_COUNT_HW_CACHE_DTLB)},
+    };
+  }
+
+  static int openCounter(std::uint32_t type, std::uint64_t config)
+  {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    // this thread on any CPU
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+
+  static bool readCounter(int fd, Reading &reading)
+  {
+    return read(fd, &reading, sizeof(reading)) == static_cast<ssize_t>(sizeof(reading));
+  }
+#endif
+};
+
+} // namespace bench
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_PERFCOUNTERS_H
@@ -0,0 +1,262 @@
+#ifndef AISDI_LINEAR_POSITIONINDEX_H
+#define AISDI_LINEAR_POSITIONINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+/**
+ * @brief links of a list node in the position index. Lists without
+ *        the index derive their nodes from the empty specialization.
+ */
+template <bool Indexed>
+struct IndexLinks
+{
+};
+
+template <>
+struct IndexLinks<true>
+{
+  IndexLinks *parent = nullptr;
+  IndexLinks *left = nullptr;
+  IndexLinks *right = nullptr;
+  std::size_t size = 1;
+};
+
+/**
+ * @brief order statistic overlay of a linked list: a treap ordered by
+ *        position, whose nodes are the list nodes themselves.
+ *
+ *        Priorities are a hash of the node address, so the tree needs no
+ *        state of its own. Its root is kept in the 'left' link of the guard
+ *        node, which therefore travels with the guard when lists are moved.
+ *        Every operation takes O(log n) expected time, rebuild() takes O(n).
+ */
+class PositionIndex
+{
+public:
+  using Links = IndexLinks<true>;
+
+  static std::size_t size(const Links *guard) { return sizeOf(guard->left); }
+
+  /**
+   * @brief position of 'node' in the list, the guard is at size()
+   */
+  static std::size_t rank(const Links *node, const Links *guard)
+  {
+    if (node == guard)
+      return size(guard);
+
+    std::size_t result = sizeOf(node->left);
+    for (; node->parent; node = node->parent)
+    {
+      if (node == node->parent->right)
+        result += sizeOf(node->parent->left) + 1;
+    }
+    return result;
+  }
+
+  /**
+   * @brief node at 'index', the guard for index >= size()
+   */
+  static Links *select(Links *guard, std::size_t index)
+  {
+    if (index >= size(guard))
+      return guard;
+
+    Links *tree = guard->left;
+    while (true)
+    {
+      std::size_t leftSize = sizeOf(tree->left);
+      if (index < leftSize)
+      {
+        tree = tree->left;
+      }
+      else if (index == leftSize)
+      {
+        return tree;
+      }
+      else
+      {
+        index -= leftSize + 1;
+        tree = tree->right;
+      }
+    }
+  }
+
+  static void insert(Links *guard, Links *node, std::size_t index)
+  {
+    node->left = nullptr;
+    node->right = nullptr;
+    node->size = 1;
+    paste(guard, node, index);
+  }
+
+  static void erase(Links *guard, Links *node)
+  {
+    Links *child = merge(node->left, node->right);
+    Links *parent = node->parent;
+    if (child)
+      child->parent = parent;
+
+    if (!parent)
+    {
+      guard->left = child;
+      return;
+    }
+
+    (parent->left == node ? parent->left : parent->right) = child;
+    for (; parent; parent = parent->parent)
+      --parent->size;
+  }
+
+  /**
+   * @brief detaches positions [from, to) and returns them as a tree
+   */
+  static Links *cut(Links *guard, std::size_t from, std::size_t to)
+  {
+    auto front = split(guard->left, from);
+    auto back = split(front.second, to - from);
+    setRoot(guard, merge(front.first, back.second));
+
+    if (back.first)
+      back.first->parent = nullptr;
+    return back.first;
+  }
+
+  /**
+   * @brief inserts a tree returned by cut() so that it starts at 'index'
+   */
+  static void paste(Links *guard, Links *tree, std::size_t index)
+  {
+    auto parts = split(guard->left, index);
+    setRoot(guard, merge(merge(parts.first, tree), parts.second));
+  }
+
+  static void clear(Links *guard) { guard->left = nullptr; }
+
+  /**
+   * @brief builds the tree anew from the list order in linear time, as
+   *        a Cartesian tree: every node is attached to the right spine
+   *        built so far. 'next' returns the node following its argument.
+   */
+  template <typename Next>
+  static void rebuild(Links *guard, Links *first, Next next)
+  {
+    Links *root = nullptr, *last = nullptr;
+    for (Links *node = first; node != guard; node = next(node))
+    {
+      Links *parent = last, *child = nullptr;
+      while (parent && priority(parent) < priority(node))
+      {
+        child = parent;
+        parent = parent->parent;
+      }
+
+      node->left = child;
+      node->right = nullptr;
+      if (child)
+        child->parent = node;
+      node->parent = parent;
+      if (parent)
+        parent->right = node;
+      else
+        root = node;
+
+      last = node;
+    }
+
+    guard->left = root;
+    computeSizes(root);
+  }
+
+private:
+  static std::size_t sizeOf(const Links *tree) { return tree ? tree->size : 0; }
+
+  // the splitmix64 finalizer, a bijection, so distinct nodes never tie
+  static std::uint64_t priority(const Links *node)
+  {
+    auto x = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(node));
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  static void update(Links *tree)
+  {
+    tree->size = 1 + sizeOf(tree->left) + sizeOf(tree->right);
+    if (tree->left)
+      tree->left->parent = tree;
+    if (tree->right)
+      tree->right->parent = tree;
+  }
+
+  static void setRoot(Links *guard, Links *tree)
+  {
+    guard->left = tree;
+    if (tree)
+      tree->parent = nullptr;
+  }
+
+  /**
+   * @brief splits 'tree' into its first 'count' positions and the rest
+   */
+  static std::pair<Links *, Links *> split(Links *tree, std::size_t count)
+  {
+    if (!tree)
+      return {nullptr, nullptr};
+
+    if (sizeOf(tree->left) >= count)
+    {
+      auto parts = split(tree->left, count);
+      tree->left = parts.second;
+      update(tree);
+      return {parts.first, tree};
+    }
+
+    auto parts = split(tree->right, count - sizeOf(tree->left) - 1);
+    tree->right = parts.first;
+    update(tree);
+    return {tree, parts.second};
+  }
+
+  static Links *merge(Links *front, Links *back)
+  {
+    if (!front)
+      return back;
+    if (!back)
+      return front;
+
+    if (priority(front) > priority(back))
+    {
+      front->right = merge(front->right, back);
+      update(front);
+      return front;
+    }
+
+    back->left = merge(front, back->left);
+    update(back);
+    return back;
+  }
+
+  static std::size_t computeSizes(Links *tree)
+  {
+    if (!tree)
+      return 0;
+
+    tree->size = 1 + computeSizes(tree->left) + computeSizes(tree->right);
+    return tree->size;
+  }
+};
+
+} // namespace detail
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_POSITIONINDEX_H
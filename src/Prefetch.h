@@ -0,0 +1,27 @@
+#ifndef AISDI_LINEAR_PREFETCH_H
+#define AISDI_LINEAR_PREFETCH_H
+
+namespace aisdi
+{
+
+namespace detail
+{
+
+/**
+ * @brief hints the processor to start loading the cache line of 'address'
+ *        for reading. A no-op on compilers without __builtin_prefetch.
+ */
+inline void prefetch(const void *address)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0, 3);
+#else
+  (void)address;
+#endif
+}
+
+} // namespace detail
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_PREFETCH_H
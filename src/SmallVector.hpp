@@ -0,0 +1,88 @@
+#ifndef AISDI_LINEAR_SMALLVECTOR_H
+#define AISDI_LINEAR_SMALLVECTOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+#include "Vector.hpp"
+
+namespace aisdi
+{
+
+/**
+ * @brief Vector that keeps up to N elements inside the object itself.
+ *        Only when the N+1st element is added the elements are moved to
+ *        the heap, and they come back once the vector shrinks enough
+ *        (or on shrinkToFit()). Short sequences never allocate.
+ *
+ *        SmallVector is a Vector, so it can be passed wherever a Vector
+ *        reference is expected and uses the same iterators.
+ */
+template <typename Type, std::size_t N, typename Policy = DefaultGrowthPolicy,
+          typename Allocator = std::allocator<Type>>
+class SmallVector : public Vector<Type, Policy, Allocator>
+{
+  static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+  using Base = Vector<Type, Policy, Allocator>;
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  // Vector keeps the inline capacity and the storage offset in narrow fields
+  static_assert(N <= UINT32_MAX, "Inline capacity too large");
+  static_assert(sizeof(Base) + alignof(Type) <= UINT16_MAX, "Inline storage too far from the Vector part");
+
+public:
+  using size_type = typename Base::size_type;
+
+  SmallVector() : SmallVector(Allocator()) {}
+  explicit SmallVector(const Allocator &allocator) : Base(inlineArray(), N, allocator) {}
+  SmallVector(std::initializer_list<Type> l, const Allocator &allocator = Allocator())
+      : SmallVector(allocator)
+  {
+    Base::reserve(l.size());
+    for (const auto &elem : l)
+      Base::append(elem);
+  }
+  SmallVector(const SmallVector &other) : SmallVector(static_cast<const Base &>(other)) {}
+  SmallVector(const Base &other)
+      : SmallVector(AllocatorTraits::select_on_container_copy_construction(other.getAllocator()))
+  {
+    Base::operator=(other);
+  }
+  SmallVector(SmallVector &&other) : SmallVector(static_cast<Base &&>(other)) {}
+  SmallVector(Base &&other) : SmallVector(other.getAllocator())
+  {
+    Base::operator=(std::move(other));
+  }
+
+  SmallVector &operator=(const SmallVector &other)
+  {
+    Base::operator=(other);
+    return *this;
+  }
+  SmallVector &operator=(SmallVector &&other)
+  {
+    Base::operator=(std::move(other));
+    return *this;
+  }
+
+  /**
+   * @brief true while the elements are kept in the inline storage
+   */
+  bool isInline() const { return Base::isUsingInlineArray(); }
+
+  static constexpr size_type inlineCapacity() { return N; }
+
+private:
+  // raw storage, elements are constructed in it by Vector
+  alignas(Type) unsigned char _inlineStorage[sizeof(Type) * N];
+
+  Type *inlineArray() { return reinterpret_cast<Type *>(_inlineStorage); }
+};
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_SMALLVECTOR_H
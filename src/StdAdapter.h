@@ -0,0 +1,86 @@
+#ifndef AISDI_LINEAR_STDADAPTER_H
+#define AISDI_LINEAR_STDADAPTER_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace aisdi
+{
+
+namespace bench
+{
+
+/**
+ * @brief gives a standard sequence container (std::vector, std::deque,
+ *        std::list) the interface of the aisdi containers, so that the same
+ *        benchmark code runs against both
+ */
+template <typename Container>
+class StdAdapter : public Container
+{
+public:
+  using value_type = typename Container::value_type;
+  using size_type = typename Container::size_type;
+
+  using Container::Container;
+
+  bool isEmpty() const { return this->empty(); }
+  size_type getSize() const { return this->size(); }
+
+  void append(const value_type &item) { this->push_back(item); }
+  void prepend(const value_type &item) { this->insert(this->begin(), item); }
+
+  value_type popFirst()
+  {
+    value_type item = std::move(this->front());
+    this->erase(this->begin());
+    return item;
+  }
+
+  value_type popLast()
+  {
+    value_type item = std::move(this->back());
+    this->pop_back();
+    return item;
+  }
+};
+
+namespace detail
+{
+
+template <typename Iterator, typename = void>
+struct HasIteratorPlus : std::false_type
+{
+};
+
+template <typename Iterator>
+struct HasIteratorPlus<Iterator, std::void_t<decltype(std::declval<Iterator>() + std::ptrdiff_t{})>>
+  : std::true_type
+{
+};
+
+} // namespace detail
+
+/**
+ * @brief iterator to the element at 'index', through the container's own
+ *        operator+ where it has one (IndexedLinkedList answers it in
+ *        O(log n)), stepping from begin() otherwise
+ */
+template <typename Collection>
+auto iteratorAt(Collection &collection, std::size_t index)
+{
+  auto iterator = collection.begin();
+  const auto offset = static_cast<std::ptrdiff_t>(index);
+  if constexpr (detail::HasIteratorPlus<decltype(iterator)>::value)
+    return iterator + offset;
+  else
+    return std::next(iterator, offset);
+}
+
+} // namespace bench
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_STDADAPTER_H
@@ -0,0 +1,626 @@
+#ifndef AISDI_LINEAR_UNROLLEDLINKEDLIST_H
+#define AISDI_LINEAR_UNROLLEDLINKEDLIST_H
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "Checks.h"
+#include "Vector.hpp"
+
+namespace aisdi
+{
+
+/**
+ * @brief doubly linked list of nodes holding up to K elements each.
+ *
+ *        A scan touches one node header per K elements and reads the
+ *        elements from a contiguous array, instead of chasing a pointer per
+ *        element like LinkedList does. A full node is split in halves when
+ *        an element is inserted into it, a node that falls below a quarter
+ *        of K elements is merged with a neighbour when they fit together.
+ *
+ *        Inserting or erasing invalidates the iterators to the elements of
+ *        the nodes involved, like in a Vector, so unlike LinkedList
+ *        iterators should not be kept across modifications.
+ */
+template <typename Type, std::size_t K = 16>
+class UnrolledLinkedList
+{
+  static_assert(K >= 2, "A node has to hold at least two elements to be split");
+
+  struct Links
+  {
+    Links *next;
+    Links *prev;
+  };
+
+  struct Node : Links
+  {
+    std::size_t count = 0;
+    // raw storage, only the first 'count' elements are constructed
+    alignas(Type) unsigned char storage[sizeof(Type) * K];
+
+    Type *items() { return reinterpret_cast<Type *>(storage); }
+    const Type *items() const { return reinterpret_cast<const Type *>(storage); }
+  };
+
+public:
+  using difference_type = std::ptrdiff_t;
+  using size_type = std::size_t;
+  using value_type = Type;
+  using pointer = Type *;
+  using reference = Type &;
+  using const_pointer = const Type *;
+  using const_reference = const Type &;
+
+  class ConstIterator;
+  class Iterator;
+  using iterator = Iterator;
+  using const_iterator = ConstIterator;
+
+  static constexpr size_type nodeCapacity() { return K; }
+
+  UnrolledLinkedList() : _size(0)
+  {
+    _guard.next = &_guard;
+    _guard.prev = &_guard;
+  }
+  UnrolledLinkedList(std::initializer_list<Type> l) : UnrolledLinkedList()
+  {
+    for (const auto &elem : l)
+      append(elem);
+  }
+  UnrolledLinkedList(const UnrolledLinkedList &other) : UnrolledLinkedList()
+  {
+    for (const auto &elem : other)
+      append(elem);
+  }
+  UnrolledLinkedList(UnrolledLinkedList &&other) : UnrolledLinkedList()
+  {
+    takeNodesFrom(other);
+  }
+  ~UnrolledLinkedList()
+  {
+    clear();
+  }
+
+  UnrolledLinkedList &operator=(const UnrolledLinkedList &other)
+  {
+    if (this == &other)
+      return *this;
+
+    clear();
+    for (const auto &item : other)
+      append(item);
+
+    return *this;
+  }
+  UnrolledLinkedList &operator=(UnrolledLinkedList &&other)
+  {
+    if (this == &other)
+      return *this;
+
+    clear();
+    takeNodesFrom(other);
+
+    return *this;
+  }
+
+  bool isEmpty() const { return _size == 0; }
+  size_type getSize() const { return _size; }
+
+  void append(const Type &item) { emplaceBack(item); }
+  void append(Type &&item) { emplaceBack(std::move(item)); }
+  void prepend(const Type &item) { emplaceFront(item); }
+  void prepend(Type &&item) { emplaceFront(std::move(item)); }
+  void insert(const const_iterator &insertPosition, const Type &item)
+  {
+    emplace(insertPosition, item);
+  }
+  void insert(const const_iterator &insertPosition, Type &&item)
+  {
+    emplace(insertPosition, std::move(item));
+  }
+
+  /**
+   * @brief constructs a new last element in place from 'args'
+   * @return reference to the new element
+   */
+  template <typename... Args>
+  Type &emplaceBack(Args &&... args)
+  {
+    return emplaceAt(&_guard, 0, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  Type &emplaceFront(Args &&... args)
+  {
+    return emplaceAt(_guard.next, 0, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  Type &emplace(const const_iterator &position, Args &&... args)
+  {
+    return emplaceAt(const_cast<Links *>(position._node), position._index, std::forward<Args>(args)...);
+  }
+
+  Type popFirst()
+  {
+    if (_size == 0)
+      throw std::out_of_range("Popped empty list");
+
+    Node *node = asNode(_guard.next);
+    Type value(std::move(node->items()[0]));
+    eraseAt(node, 0);
+
+    return value;
+  }
+
+  Type popLast()
+  {
+    if (_size == 0)
+      throw std::out_of_range("Popped empty list");
+
+    Node *node = asNode(_guard.prev);
+    Type value(std::move(node->items()[node->count - 1]));
+    eraseAt(node, node->count - 1);
+
+    return value;
+  }
+
+  void erase(const const_iterator &possition)
+  {
+    if (_size == 0)
+      throw std::out_of_range("Erasing empty list");
+    if (possition == cend())
+      throw std::out_of_range("Erasing end iterator");
+
+    eraseAt(asNode(const_cast<Links *>(possition._node)), possition._index);
+  }
+
+  /**
+   * @brief removes [firstIncluded, lastExcluded) node by node, every node
+   *        is shifted at most once and the emptied ones are freed whole
+   */
+  void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
+  {
+    size_type toRemove = 0;
+    for (auto it = firstIncluded; it != lastExcluded; ++it)
+      ++toRemove;
+
+    Links *link = const_cast<Links *>(firstIncluded._node);
+    size_type index = firstIncluded._index;
+
+    // the nodes keeping a prefix and a suffix of their elements
+    Node *prefixNode = nullptr, *suffixNode = nullptr;
+
+    while (toRemove > 0)
+    {
+      Node *node = asNode(link);
+      size_type removed = std::min(toRemove, node->count - index);
+
+      Mover::shiftLeft(node->items(), index + removed, node->count, removed);
+      node->count -= removed;
+      _size -= removed;
+      toRemove -= removed;
+
+      link = node->next;
+      if (node->count == 0)
+        unlinkNode(node);
+      else if (index > 0)
+        prefixNode = node;
+      else
+        suffixNode = node;
+
+      index = 0;
+    }
+
+    // neither can free the other one, see rebalance()
+    if (suffixNode)
+      rebalance(suffixNode);
+    if (prefixNode)
+      rebalance(prefixNode);
+  }
+
+  /**
+   * @brief removes all elements and frees all nodes
+   */
+  void clear()
+  {
+    for (Links *it = _guard.next; it != &_guard;)
+    {
+      Links *next = it->next;
+      Node *node = asNode(it);
+      Mover::destroy(node->items(), node->count);
+      delete node;
+      it = next;
+    }
+
+    _guard.next = &_guard;
+    _guard.prev = &_guard;
+    _size = 0;
+  }
+
+  iterator       begin()        { return iterator(_guard.next, 0, &_guard); }
+  iterator       end()          { return iterator(&_guard, 0, &_guard); }
+  const_iterator cbegin() const { return const_iterator(_guard.next, 0, &_guard); }
+  const_iterator cend()   const { return const_iterator(&_guard, 0, &_guard); }
+  const_iterator begin()  const { return cbegin(); }
+  const_iterator end()    const { return cend(); }
+
+private:
+  // the guard carries no elements, so it is only the links part of a node
+  Links _guard;
+  size_type _size;
+
+  using Mover = detail::ElementMover<Type>;
+
+  static constexpr size_type minFill = K / 4;
+
+  static Node *asNode(Links *link) { return static_cast<Node *>(link); }
+  static const Node *asNode(const Links *link) { return static_cast<const Node *>(link); }
+
+  Node *createNodeAfter(Links *left)
+  {
+    Node *node = new Node;
+    node->prev = left;
+    node->next = left->next;
+    left->next->prev = node;
+    left->next = node;
+    return node;
+  }
+
+  void unlinkNode(Node *node)
+  {
+    node->prev->next = node->next;
+    node->next->prev = node->prev;
+    delete node;
+  }
+
+  void takeNodesFrom(UnrolledLinkedList &other)
+  {
+    if (other._size == 0)
+      return;
+
+    _guard.next = other._guard.next;
+    _guard.prev = other._guard.prev;
+    _guard.next->prev = &_guard;
+    _guard.prev->next = &_guard;
+    _size = other._size;
+
+    other._guard.next = &other._guard;
+    other._guard.prev = &other._guard;
+    other._size = 0;
+  }
+
+  /**
+   * @brief inserts a new element before the one at 'index' of 'link',
+   *        the guard stands for the end of the list
+   */
+  template <typename... Args>
+  Type &emplaceAt(Links *link, size_type index, Args &&... args)
+  {
+    Node *node;
+    if (link == &_guard)
+    {
+      // appending, fill the last node before starting a new one
+      Links *last = _guard.prev;
+      node = last != &_guard && asNode(last)->count < K ? asNode(last) : createNodeAfter(last);
+      return constructAtEnd(node, std::forward<Args>(args)...);
+    }
+
+    node = asNode(link);
+    if (index == 0 && node->count == K)
+    {
+      // in front of a full node, use the end of the previous one
+      Links *prev = node->prev;
+      node = prev != &_guard && asNode(prev)->count < K ? asNode(prev) : createNodeAfter(prev);
+      return constructAtEnd(node, std::forward<Args>(args)...);
+    }
+
+    // built before anything moves, args might refer to our own elements
+    Type temp(std::forward<Args>(args)...);
+
+    if (node->count == K)
+    {
+      Node *upper = createNodeAfter(node);
+      size_type half = K / 2;
+      Mover::relocate(upper->items(), node->items() + half, K - half);
+      upper->count = K - half;
+      node->count = half;
+
+      if (index > half)
+      {
+        node = upper;
+        index -= half;
+      }
+    }
+
+    if (index == node->count)
+      return constructAtEnd(node, std::move(temp));
+
+    Mover::shiftRight(node->items(), index, node->count);
+    node->items()[index] = std::move(temp);
+    ++node->count;
+    ++_size;
+
+    return node->items()[index];
+  }
+
+  template <typename... Args>
+  Type &constructAtEnd(Node *node, Args &&... args)
+  {
+    Type *item = new (node->items() + node->count) Type(std::forward<Args>(args)...);
+    ++node->count;
+    ++_size;
+    return *item;
+  }
+
+  void eraseAt(Node *node, size_type index)
+  {
+    Mover::shiftLeft(node->items(), index + 1, node->count, 1);
+    --node->count;
+    --_size;
+
+    rebalance(node);
+  }
+
+  /**
+   * @brief frees an empty node, merges a sparse one with a neighbour when
+   *        both fit into one node. Only 'node' or its successor are freed.
+   */
+  void rebalance(Node *node)
+  {
+    if (node->count == 0)
+    {
+      unlinkNode(node);
+      return;
+    }
+    if (node->count >= minFill)
+      return;
+
+    Links *next = node->next;
+    if (next != &_guard && node->count + asNode(next)->count <= K)
+    {
+      mergeWithNext(node);
+      return;
+    }
+
+    Links *prev = node->prev;
+    if (prev != &_guard && asNode(prev)->count + node->count <= K)
+      mergeWithNext(asNode(prev));
+  }
+
+  void mergeWithNext(Node *node)
+  {
+    Node *next = asNode(node->next);
+    Mover::relocate(node->items() + node->count, next->items(), next->count);
+    node->count += next->count;
+    next->count = 0;
+    unlinkNode(next);
+  }
+};
+
+/**
+ * @brief bidirectional iterator, a node and an index within it
+ */
+template <typename Type, std::size_t K>
+class UnrolledLinkedList<Type, K>::ConstIterator
+{
+public:
+  using iterator_category = std::bidirectional_iterator_tag;
+  using value_type = typename UnrolledLinkedList::value_type;
+  using difference_type = typename UnrolledLinkedList::difference_type;
+  using pointer = typename UnrolledLinkedList::const_pointer;
+  using reference = typename UnrolledLinkedList::const_reference;
+
+  explicit ConstIterator() : _node(nullptr), _index(0), _guard(nullptr) {}
+  explicit ConstIterator(const Links *node, size_type index, const Links *guard)
+      : _node(node), _index(index), _guard(guard)
+  {
+  }
+
+  reference operator*() const
+  {
+    if (detail::checked)
+    {
+      if (_node == nullptr)
+        throw std::out_of_range("Dereferencing uninitialized iterator");
+      if (_node == _guard)
+        throw std::out_of_range("Dereferencing end iterator");
+    }
+
+    return asNode(_node)->items()[_index];
+  }
+
+  pointer operator->() const
+  {
+    return &**this;
+  }
+
+  ConstIterator &operator++()
+  {
+    if (detail::checked && _node == _guard)
+      throw std::out_of_range("Incrementing end iterator");
+
+    if (++_index == asNode(_node)->count)
+    {
+      _node = _node->next;
+      _index = 0;
+    }
+    return *this;
+  }
+
+  ConstIterator operator++(int)
+  {
+    auto temp = *this;
+    ++*this;
+    return temp;
+  }
+
+  ConstIterator &operator--()
+  {
+    if (_index > 0)
+    {
+      --_index;
+      return *this;
+    }
+
+    if (detail::checked && _node->prev == _guard)
+      throw std::out_of_range("Decrementing begin iterator");
+
+    _node = _node->prev;
+    _index = asNode(_node)->count - 1;
+    return *this;
+  }
+
+  ConstIterator operator--(int)
+  {
+    auto temp = *this;
+    --*this;
+    return temp;
+  }
+
+  /**
+   * @brief skips whole nodes, so it takes O(d / K) steps
+   */
+  ConstIterator operator+(difference_type d) const
+  {
+    if (d < 0)
+      return *this - (-d);
+
+    auto temp = *this;
+    size_type left = d;
+    while (left > 0)
+    {
+      if (detail::checked && temp._node == _guard)
+        throw std::out_of_range("Adding iterator pass the end");
+
+      size_type inNode = asNode(temp._node)->count - temp._index;
+      if (left < inNode)
+      {
+        temp._index += left;
+        break;
+      }
+
+      left -= inNode;
+      temp._node = temp._node->next;
+      temp._index = 0;
+    }
+
+    return temp;
+  }
+
+  ConstIterator operator-(difference_type d) const
+  {
+    if (d < 0)
+      return *this + (-d);
+
+    auto temp = *this;
+    size_type left = d;
+    while (left > temp._index)
+    {
+      if (detail::checked && temp._node->prev == _guard)
+        throw std::out_of_range("Substracting iterator pass the begining");
+
+      left -= temp._index;
+      temp._node = temp._node->prev;
+      temp._index = asNode(temp._node)->count;
+    }
+    temp._index -= left;
+
+    return temp;
+  }
+
+  bool operator==(const ConstIterator &other) const
+  {
+    return _node == other._node && _index == other._index;
+  }
+
+  bool operator!=(const ConstIterator &other) const
+  {
+    return !(*this == other);
+  }
+
+private:
+  const Links *_node;
+  size_type _index;
+  const Links *_guard;
+
+  friend class UnrolledLinkedList;
+};
+
+template <typename Type, std::size_t K>
+class UnrolledLinkedList<Type, K>::Iterator : public UnrolledLinkedList<Type, K>::ConstIterator
+{
+public:
+  using pointer = typename UnrolledLinkedList::pointer;
+  using reference = typename UnrolledLinkedList::reference;
+
+  explicit Iterator() : ConstIterator()
+  {
+  }
+
+  explicit Iterator(const Links *node, size_type index, const Links *guard) : ConstIterator(node, index, guard)
+  {
+  }
+
+  Iterator(const ConstIterator &other)
+      : ConstIterator(other)
+  {
+  }
+
+  Iterator &operator++()
+  {
+    ConstIterator::operator++();
+    return *this;
+  }
+
+  Iterator operator++(int)
+  {
+    auto result = *this;
+    ConstIterator::operator++();
+    return result;
+  }
+
+  Iterator &operator--()
+  {
+    ConstIterator::operator--();
+    return *this;
+  }
+
+  Iterator operator--(int)
+  {
+    auto result = *this;
+    ConstIterator::operator--();
+    return result;
+  }
+
+  Iterator operator+(difference_type d) const
+  {
+    return ConstIterator::operator+(d);
+  }
+
+  Iterator operator-(difference_type d) const
+  {
+    return ConstIterator::operator-(d);
+  }
+
+  reference operator*() const
+  {
+    // ugly cast, yet reduces code duplication.
+    return const_cast<reference>(ConstIterator::operator*());
+  }
+
+  pointer operator->() const
+  {
+    return &**this;
+  }
+};
+
+} // namespace aisdi
+
+#endif // AISDI_LINEAR_UNROLLEDLINKEDLIST_H
@@ -1,19 +1,189 @@
 #ifndef AISDI_LINEAR_VECTOR_H
 #define AISDI_LINEAR_VECTOR_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <initializer_list>
+#include <iterator>
 #include <stdexcept>
 #include <iostream>
 #include <cassert>
+#include <cstring>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "BackgroundReclaimer.h"
+#include "Checks.h"
+#include "Instrumentation.h"
 
 namespace aisdi
 {
 
+namespace detail
+{
+
+/**
+ * @brief element shifting and relocation used by the array based containers.
+ *        Generic version works element by element with move construction
+ *        and move assignment.
+ */
+template <typename Type, bool = std::is_trivially_copyable<Type>::value>
+struct ElementMover
+{
+  /**
+   * @brief move-constructs 'count' elements from 'source' into
+   *        uninitialized 'destination' and destroys the originals
+   */
+  static void relocate(Type *destination, Type *source, std::size_t count)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      new (destination + i) Type(std::move(source[i]));
+      source[i].~Type();
+    }
+  }
+
+  /**
+   * @brief shifts [from, size) one slot right. The last element is
+   *        move-constructed into the free slot at 'size', the rest is
+   *        move-assigned, so 'from' is left holding a moved-from object.
+   */
+  static void shiftRight(Type *array, std::size_t from, std::size_t size)
+  {
+    new (array + size) Type(std::move(array[size - 1]));
+    std::move_backward(array + from, array + size - 1, array + size);
+  }
+
+  /**
+   * @brief shifts [from, size) 'jump' slots left and destroys
+   *        the 'jump' trailing objects left behind
+   */
+  static void shiftLeft(Type *array, std::size_t from, std::size_t size, std::size_t jump)
+  {
+    std::move(array + from, array + size, array + from - jump);
+
+    for (std::size_t i = size - jump; i < size; ++i)
+      array[i].~Type();
+  }
+
+  static void destroy(Type *array, std::size_t count)
+  {
+    for (std::size_t i = 0; i < count; ++i)
+      array[i].~Type();
+  }
+};
+
+/**
+ * @brief trivially copyable types can be moved around as raw bytes,
+ *        so every operation is a single memcpy/memmove
+ */
 template <typename Type>
-class Vector
+struct ElementMover<Type, true>
+{
+  static void relocate(Type *destination, Type *source, std::size_t count)
+  {
+    if (count != 0)
+      std::memcpy(destination, source, count * sizeof(Type));
+  }
+
+  static void shiftRight(Type *array, std::size_t from, std::size_t size)
+  {
+    std::memmove(array + from + 1, array + from, (size - from) * sizeof(Type));
+  }
+
+  static void shiftLeft(Type *array, std::size_t from, std::size_t size, std::size_t jump)
+  {
+    std::memmove(array + from - jump, array + from, (size - from) * sizeof(Type));
+  }
+
+  // trivially copyable types are trivially destructible as well
+  static void destroy(Type *, std::size_t) {}
+};
+
+} // namespace detail
+
+/**
+ * @brief capacity management policy of Vector.
+ *
+ *        The first allocation takes InitialCapacity slots and every time the
+ *        vector is full its capacity is multiplied by
+ *        GrowthNumerator / GrowthDenominator. When the size drops below
+ *        capacity / ShrinkBelowDivisor the capacity is divided by
+ *        ShrinkByDivisor, but never below InitialCapacity.
+ *        ShrinkBelowDivisor == 0 disables shrinking altogether.
+ *
+ *        Leaving a gap between the two thresholds (e.g. grow at full,
+ *        shrink at a quarter) keeps workloads that hover around a boundary
+ *        from reallocating on every operation.
+ */
+template <std::size_t InitialCapacity = 8,
+          std::size_t GrowthNumerator = 2,
+          std::size_t GrowthDenominator = 1,
+          std::size_t ShrinkBelowDivisor = 4,
+          std::size_t ShrinkByDivisor = 2>
+struct GrowthPolicy
+{
+  static_assert(InitialCapacity > 0, "Initial capacity has to be positive");
+  static_assert(GrowthNumerator > GrowthDenominator, "Growth factor has to be greater than one");
+  static_assert(ShrinkBelowDivisor == 0 || ShrinkBelowDivisor > ShrinkByDivisor,
+                "Shrinking by more than the threshold would leave no room for the next append");
+
+  static std::size_t initialCapacity() { return InitialCapacity; }
+
+  static std::size_t grow(std::size_t capacity)
+  {
+    if (capacity == 0)
+      return InitialCapacity;
+
+    std::size_t grown = capacity / GrowthDenominator * GrowthNumerator +
+                        capacity % GrowthDenominator * GrowthNumerator / GrowthDenominator;
+    return grown > capacity ? grown : capacity + 1;
+  }
+
+  /**
+   * @brief returns the capacity the vector should have after it was
+   *        reduced to 'size' elements, or 'capacity' if it should not shrink
+   */
+  static std::size_t shrink(std::size_t size, std::size_t capacity)
+  {
+    if (ShrinkBelowDivisor == 0 || capacity <= InitialCapacity || size >= capacity / ShrinkBelowDivisor)
+      return capacity;
+
+    std::size_t shrunk = capacity / ShrinkByDivisor;
+    return shrunk < InitialCapacity ? InitialCapacity : shrunk;
+  }
+};
+
+using DefaultGrowthPolicy = GrowthPolicy<>;
+
+// capacity only ever grows, memory is given back by shrinkToFit() alone
+using NeverShrinkPolicy = GrowthPolicy<8, 2, 1, 0>;
+
+/**
+ * @brief dynamic array. Storage comes from 'Allocator', which is copied,
+ *        moved and assigned along with the vector as its
+ *        propagate_on_container_* traits say (see std::allocator_traits).
+ *        Elements themselves are always constructed with placement new.
+ *
+ *        With AISDI_LINEAR_INSTRUMENTED set, the vector counts its buffer
+ *        allocations and reallocations, see Instrumentation.h.
+ */
+template <typename Type, typename Policy = DefaultGrowthPolicy, typename Allocator = std::allocator<Type>>
+class Vector : private detail::AllocationCounter<>
 {
+  using AllocatorTraits = std::allocator_traits<Allocator>;
+
+  static_assert(std::is_same<typename AllocatorTraits::value_type, Type>::value,
+                "Allocator has to allocate elements of the vector");
+  static_assert(std::is_same<typename AllocatorTraits::pointer, Type *>::value,
+                "Fancy pointers are not supported");
+
 public:
+  using allocator_type = Allocator;
   using difference_type = std::ptrdiff_t;
   using size_type = std::size_t;
   using value_type = Type;
@@ -27,30 +197,45 @@ public:
   using iterator = Iterator;
   using const_iterator = ConstIterator;
 
-  Vector() : _array(nullptr), _capacity(0), _size(0) {}
-  Vector(std::initializer_list<Type> l) : _size(0)
+  Vector() : Vector(Allocator()) {}
+  explicit Vector(const Allocator &allocator)
+      : _allocator(allocator), _inlineOffset(0), _inlineCapacity(0), _array(nullptr), _capacity(0), _size(0)
   {
-    size_t size = l.size();
-    _array = new Type[size];
-    _capacity = size;
-
-    for (auto &&elem : l)
-      append(elem); //&& somehow(rvalue move)?
   }
-  Vector(const Vector &other) : _array(new Type[other._size]), _capacity(other._capacity), _size(0)
+  Vector(std::initializer_list<Type> l, const Allocator &allocator = Allocator())
+      : _allocator(allocator), _inlineOffset(0), _inlineCapacity(0),
+        _array(allocate(l.size())), _capacity(l.size()), _size(0)
+  {
+    for (const auto &elem : l)
+      constructAtEnd(elem);
+  }
+  Vector(const Vector &other)
+      : Vector(other, AllocatorTraits::select_on_container_copy_construction(other._allocator))
+  {
+  }
+  Vector(const Vector &other, const Allocator &allocator)
+      : _allocator(allocator), _inlineOffset(0), _inlineCapacity(0),
+        _array(allocate(other._size)), _capacity(other._size), _size(0)
   {
     for (const auto &elem : other)
-      append(elem);
+      constructAtEnd(elem);
+  }
+  Vector(Vector &&other) : Vector(other._allocator)
+  {
+    takeElementsFrom(other);
   }
-  Vector(Vector &&other) : _array(other._array), _capacity(other._capacity), _size(other._size)
+  /**
+   * @brief the buffer of 'other' is taken over only if 'allocator' can free
+   *        it, otherwise the elements are moved one by one
+   */
+  Vector(Vector &&other, const Allocator &allocator) : Vector(allocator)
   {
-    other._array = nullptr;
-    // other._capacity = 0;??
-    // other._size = 0;??
+    takeElementsFrom(other);
   }
   ~Vector()
   {
-    delete[] _array;
+    destroyElements(0, _size);
+    releaseArray(_array, _capacity);
   }
 
   Vector &operator=(const Vector &other)
@@ -58,12 +243,50 @@ public:
     if (this == &other)
       return *this;
 
-    delete[] _array;
-    _array = new Type[other._capacity];
-    _size = 0;
+    if constexpr (AllocatorTraits::propagate_on_container_copy_assignment::value)
+    {
+      // our buffer has to be given back to the allocator it came from
+      if (_allocator != other._allocator)
+      {
+        destroyElements(0, _size);
+        _size = 0;
+        resetToInlineArray();
+      }
+      _allocator = other._allocator;
+    }
 
-    for (auto &elem : other)
-      append(elem);
+    if (_capacity < other._size)
+    {
+      // the copy is built before the old buffer is let go, so a throwing
+      // allocation or copy leaves this vector as it was
+      Type *newArray = allocate(other._size);
+      size_type copied = 0;
+      try
+      {
+        for (; copied < other._size; ++copied)
+          new (newArray + copied) Type(other._array[copied]);
+      }
+      catch (...)
+      {
+        for (size_type i = 0; i < copied; ++i)
+          newArray[i].~Type();
+        deallocate(newArray, other._size);
+        throw;
+      }
+
+      destroyElements(0, _size);
+      releaseArray(_array, _capacity);
+      _array = newArray;
+      _capacity = other._size;
+      _size = other._size;
+      return *this;
+    }
+
+    // reuse the buffer we already own if the copy fits into it
+    destroyElements(0, _size);
+    _size = 0;
+    for (const auto &elem : other)
+      constructAtEnd(elem);
 
     return *this;
   }
@@ -72,60 +295,122 @@ public:
     if (this == &other)
       return *this;
 
-    delete[] _array;
+    destroyElements(0, _size);
+    _size = 0;
+    resetToInlineArray();
 
-    _array = other._array;
-    _capacity = other._capacity;
-    _size = other._size;
+    if constexpr (AllocatorTraits::propagate_on_container_move_assignment::value)
+      _allocator = other._allocator;
 
-    other._array = nullptr;
+    takeElementsFrom(other);
 
     return *this;
   }
   Type &operator[](const size_type index)
   {
-    //something might happen when using move assignment or constructor
-    if (_array == nullptr)
-      throw std::runtime_error("Referencing deleted vector(std::move?)");
-
-    if (index < 0 || index >= _size)
-      throw std::out_of_range("Index out of range");
-
+    checkIndex(index);
+    return _array[index];
+  }
+  const Type &operator[](const size_type index) const
+  {
+    checkIndex(index);
     return _array[index];
   }
 
   bool isEmpty() const { return _size == 0; }
   size_type getSize() const { return _size; }
   size_type getCapacity() const { return _capacity; }
+  allocator_type getAllocator() const { return _allocator; }
+  AllocationStats getAllocationStats() const { return allocationStats(); }
+
+  /**
+   * @brief makes room for at least 'capacity' elements up front, so that
+   *        appending up to that many elements never reallocates
+   */
+  void reserve(size_type capacity)
+  {
+    if (capacity > _capacity)
+      changeCapacity(capacity);
+  }
+  /**
+   * @brief releases all spare slots, capacity becomes equal to size
+   */
+  void shrinkToFit()
+  {
+    if (_capacity != _size)
+      changeCapacity(_size);
+  }
+  /**
+   * @brief empties the vector in O(1) and leaves destroying the elements
+   *        and freeing the buffer to the BackgroundReclaimer thread, so the
+   *        allocator has to be usable from there. Elements in the inline
+   *        storage of a SmallVector are destroyed right away.
+   */
+  void releaseAsync()
+  {
+    if (_array == nullptr || _array == inlineArray())
+    {
+      destroyElements(0, _size);
+      _size = 0;
+      return;
+    }
 
-  void append(const Type &item)
-  {
-    if (_size == _capacity)
-      increaseCapacityBy(2);
-
-    _array[_size++] = item;
+    // counted as freed once handed over, this vector no longer owns it
+    countFree(_capacity * sizeof(Type));
+    BackgroundReclaimer::instance().defer(
+        [allocator = _allocator, array = _array, size = _size, capacity = _capacity]() mutable {
+          for (size_type i = 0; i < size; ++i)
+            array[i].~Type();
+          AllocatorTraits::deallocate(allocator, array, capacity);
+        });
+
+    _array = inlineArray();
+    _capacity = _inlineCapacity;
+    _size = 0;
   }
-  void prepend(const Type &item)
-  {
-    if (_size == _capacity)
-      increaseCapacityBy(2);
 
-    moveElementsRight(0);
-
-    _array[0] = item;
-    ++_size;
-  }
+  void append(const Type &item) { emplaceBack(item); }
+  void append(Type &&item) { emplaceBack(std::move(item)); }
+  void prepend(const Type &item) { emplaceAt(0, item); }
+  void prepend(Type &&item) { emplaceAt(0, std::move(item)); }
   void insert(const const_iterator &insertPosition, const Type &item)
   {
-    //cannot dereference end() iterator
-    size_type index = insertPosition == end() ? _size : &(*insertPosition) - &(*begin());
+    emplaceAt(indexOf(insertPosition), item);
+  }
+  void insert(const const_iterator &insertPosition, Type &&item)
+  {
+    emplaceAt(indexOf(insertPosition), std::move(item));
+  }
 
+  /**
+   * @brief constructs a new last element in place from 'args'
+   * @return reference to the new element
+   */
+  template <typename... Args>
+  Type &emplaceBack(Args &&... args)
+  {
     if (_size == _capacity)
-      increaseCapacityBy(2);
+    {
+      // args might refer to an element of the array we are about to release,
+      // so the new element is constructed in the new one before the old is freed
+      reallocateAndEmplaceBack(std::forward<Args>(args)...);
+    }
+    else
+    {
+      constructAtEnd(std::forward<Args>(args)...);
+    }
 
-    moveElementsRight(index);
-    _array[index] = item;
-    ++_size;
+    return _array[_size - 1];
+  }
+  template <typename... Args>
+  Type &emplaceFront(Args &&... args)
+  {
+    return emplaceAt(0, std::forward<Args>(args)...);
+  }
+  template <typename... Args>
+  Type &emplace(const const_iterator &position, Args &&... args)
+  {
+    return emplaceAt(indexOf(position), std::forward<Args>(args)...);
   }
 
   Type popFirst()
@@ -133,12 +418,11 @@ public:
     if (_size == 0)
       throw std::length_error("Popped empty vector");
 
-    Type temp = _array[0];
+    Type temp(std::move(_array[0]));
     moveElementsLeft(1);
     --_size;
 
-    if (_capacity > _defaultCapacity && _size < _capacity / 4)
-      decreaseCapacityBy(2);
+    shrinkIfSparse();
 
     return temp;
   }
@@ -148,23 +432,27 @@ public:
     if (_size == 0)
       throw std::length_error("Popped empty vector");
 
-    if (_capacity > _defaultCapacity && _size < _capacity / 4)
-      decreaseCapacityBy(2);
+    Type temp(std::move(_array[_size - 1]));
+    destroyElements(_size - 1, _size);
+    --_size;
+
+    shrinkIfSparse();
 
-    return _array[--_size];
+    return temp;
   }
 
   void erase(const const_iterator &possition)
   {
     if (_size == 0)
       throw std::out_of_range("Erasing empty vector");
+    if (possition == cend())
+      throw std::out_of_range("Erasing end iterator");
 
-    size_type index = &(*possition) - &(*begin());
+    size_type index = possition - cbegin();
     moveElementsLeft(index + 1);
     --_size;
 
-    if (_size < _capacity / 4 && _capacity > _defaultCapacity)
-      decreaseCapacityBy(2);
+    shrinkIfSparse();
   }
   void erase(const const_iterator &firstIncluded, const const_iterator &lastExcluded)
   {
@@ -175,8 +463,8 @@ public:
       return;
     }
 
-    size_type index = &(*firstIncluded) - &(*begin());
-    size_type nElements = lastExcluded == end() ? _size - index : &(*lastExcluded) - &(*firstIncluded);
+    size_type index = firstIncluded - cbegin();
+    size_type nElements = lastExcluded - firstIncluded;
 
     //when? i guess might never happen...
     if (_size < nElements)
@@ -185,164 +473,394 @@ public:
     moveElementsLeft(index + nElements, nElements);
 
     _size -= nElements;
+
+    shrinkIfSparse();
+  }
+
+  /**
+   * @brief removes every element for which 'predicate' returns true in a
+   *        single pass: kept elements are moved straight to their final
+   *        slot, each at most once. Order of the kept elements is preserved.
+   * @return number of removed elements
+   */
+  template <typename Predicate>
+  size_type eraseIf(Predicate predicate)
+  {
+    size_type kept = 0;
+    for (size_type i = 0; i < _size; ++i)
+    {
+      if (predicate(static_cast<const Type &>(_array[i])))
+        continue;
+
+      if (kept != i)
+        _array[kept] = std::move(_array[i]);
+      ++kept;
+    }
+
+    size_type removed = _size - kept;
+    destroyElements(kept, _size);
+    _size = kept;
+
+    shrinkIfSparse();
+
+    return removed;
+  }
+  /**
+   * @brief removes every element equal to 'value', which must not
+   *        refer to an element of this vector
+   * @return number of removed elements
+   */
+  size_type removeAll(const Type &value)
+  {
+    return eraseIf([&value](const Type &item) { return item == value; });
   }
 
-  iterator       begin()        { return iterator(&(_array[0]), 0, this); }
-  iterator       end()          { return iterator(&_array[_size], _size, this); }
-  const_iterator cbegin() const { return const_iterator(&_array[0], 0, this); }
-  const_iterator cend()   const { return const_iterator(&_array[_size], _size, this); }
+  iterator       begin()        { return iterator(_array, this); }
+  iterator       end()          { return iterator(_array + _size, this); }
+  const_iterator cbegin() const { return const_iterator(_array, this); }
+  const_iterator cend()   const { return const_iterator(_array + _size, this); }
   const_iterator begin()  const { return cbegin(); }
   const_iterator end()    const { return cend(); }
 
+protected:
+  /**
+   * @brief used by SmallVector, 'inlineArray' is raw storage for
+   *        'inlineCapacity' elements that lives inside the derived object.
+   *        It is used whenever the elements fit and is never deallocated.
+   *        Only its distance from this object is kept.
+   */
+  Vector(Type *inlineArray, size_type inlineCapacity, const Allocator &allocator)
+      : _allocator(allocator),
+        _inlineOffset(static_cast<std::uint16_t>(reinterpret_cast<char *>(inlineArray) -
+                                                  reinterpret_cast<char *>(this))),
+        _inlineCapacity(static_cast<std::uint32_t>(inlineCapacity)),
+        _array(inlineArray), _capacity(inlineCapacity), _size(0)
+  {
+  }
+
+  bool isUsingInlineArray() const { return _array != nullptr && _array == inlineArray(); }
+
 private:
+  // declared first, the constructors allocate with it
+  Allocator _allocator;
+
+  // where a SmallVector keeps its inline storage, relative to this object,
+  // and for how many elements, 0 for a plain Vector. Both fit into the
+  // padding after an empty allocator, so a plain Vector does not grow
+  std::uint16_t _inlineOffset;
+  std::uint32_t _inlineCapacity;
+
+  // _array points to raw storage for _capacity elements,
+  // only the first _size of them are constructed
   Type*     _array;
   size_type _capacity;
   size_type _size;
 
-  static const size_type _defaultCapacity = 8;
+  using Mover = detail::ElementMover<Type>;
 
   /////////////////////////////////////////////
   ///PRIVATE METHODS//////////////////////////
   ////////////////////////////////////////////
-  void increaseCapacityBy(int factor)
+  Type *inlineArray() const
+  {
+    if (_inlineCapacity == 0)
+      return nullptr;
+
+    auto *self = reinterpret_cast<char *>(const_cast<Vector *>(this));
+    return reinterpret_cast<Type *>(self + _inlineOffset);
+  }
+  Type *allocate(size_type capacity)
   {
-    if (_capacity == 0)
+    if (capacity == 0)
+      return nullptr;
+
+    Type *array = AllocatorTraits::allocate(_allocator, capacity);
+    countAllocation(capacity * sizeof(Type));
+    return array;
+  }
+  void deallocate(Type *array, size_type capacity)
+  {
+    if (array != nullptr)
     {
-      _array = new Type[8];
-      _capacity = 8;
-      return;
+      AllocatorTraits::deallocate(_allocator, array, capacity);
+      countFree(capacity * sizeof(Type));
     }
-    _capacity = _capacity * factor;
-    changeCapacity();
   }
-  void decreaseCapacityBy(int factor)
+  void releaseArray(Type *array, size_type capacity)
+  {
+    if (array != inlineArray())
+      deallocate(array, capacity);
+  }
+  /**
+   * @brief gives back the heap buffer, expects no elements to be alive
+   */
+  void resetToInlineArray()
   {
-    _capacity = _capacity / factor;
-    changeCapacity();
+    releaseArray(_array, _capacity);
+    _array = inlineArray();
+    _capacity = _inlineCapacity;
   }
-  void changeCapacity()
+  /**
+   * @brief takes over the elements of 'other' and leaves it empty.
+   *        A heap buffer is simply stolen when our allocator can free it.
+   *        Otherwise, and for elements kept in the inline storage of
+   *        a SmallVector, the elements have to be relocated one by one.
+   *        Expects this vector to be empty and on its own inline storage.
+   */
+  void takeElementsFrom(Vector &other)
   {
-    Type *newArray = new Type[_capacity];
-    for (size_type i = 0; i < _size; i++)
+    if (other._array != other.inlineArray() && _allocator == other._allocator)
+    {
+      _array = other._array;
+      _capacity = other._capacity;
+      countTransfer(other, _capacity * sizeof(Type));
+    }
+    else
     {
-      newArray[i] = _array[i];
+      if (other._size > _capacity)
+      {
+        _array = allocate(other._size);
+        _capacity = other._size;
+      }
+      Mover::relocate(_array, other._array, other._size);
+      countRelocation(other._size);
+      other.releaseArray(other._array, other._capacity);
     }
+    _size = other._size;
+
+    other._array = other.inlineArray();
+    other._capacity = other._inlineCapacity;
+    other._size = 0;
+  }
+  void destroyElements(size_type fromIncluded, size_type toExcluded)
+  {
+    for (size_type i = fromIncluded; i < toExcluded; ++i)
+      _array[i].~Type();
+  }
+  size_type indexOf(const const_iterator &position) const
+  {
+    return position - cbegin();
+  }
+  void checkIndex(size_type index) const
+  {
+    if (detail::checked && index >= _size)
+      throw std::out_of_range("Index out of range");
+  }
+  template <typename... Args>
+  void constructAtEnd(Args &&... args)
+  {
+    new (_array + _size) Type(std::forward<Args>(args)...);
+    ++_size;
+  }
+  template <typename... Args>
+  void reallocateAndEmplaceBack(Args &&... args)
+  {
+    size_type newCapacity = Policy::grow(_capacity);
+    Type *newArray = allocate(newCapacity);
+
+    new (newArray + _size) Type(std::forward<Args>(args)...);
+    Mover::relocate(newArray, _array, _size);
+    if (_capacity != 0)
+      countReallocation(_size);
 
-    delete[] _array;
+    releaseArray(_array, _capacity);
     _array = newArray;
+    _capacity = newCapacity;
+    ++_size;
   }
-  void moveElementsRight(size_type from, int jump = 1)
+  template <typename... Args>
+  Type &emplaceAt(size_type index, Args &&... args)
   {
-    if (_size == 0)
-      return;
-      
-    assert(from >= 0);
+    if (index == _size)
+      return emplaceBack(std::forward<Args>(args)...);
+
+    // built before shifting, args might refer to our own elements
+    Type temp(std::forward<Args>(args)...);
+
+    if (_size == _capacity)
+      changeCapacity(Policy::grow(_capacity));
+
+    moveElementsRight(index);
+    _array[index] = std::move(temp);
+    ++_size;
+
+    return _array[index];
+  }
+  /**
+   * @brief applies the shrink policy until it is satisfied, so that
+   *        removing many elements at once ends with the same capacity
+   *        as removing them one by one, but reallocates only once
+   */
+  void shrinkIfSparse()
+  {
+    size_type newCapacity = _capacity;
+    for (size_type next = Policy::shrink(_size, newCapacity); next != newCapacity;
+         next = Policy::shrink(_size, newCapacity))
+      newCapacity = next;
 
-    size_type to = _size - 1;
-    while (true)
+    if (newCapacity != _capacity)
+      changeCapacity(newCapacity);
+  }
+  void changeCapacity(size_type newCapacity)
+  {
+    assert(newCapacity >= _size);
+
+    Type *newArray;
+    if (newCapacity <= _inlineCapacity)
     {
-      _array[to + jump] = _array[to];
-      if (to <= from)
+      // everything fits into the inline storage again
+      if (_array == inlineArray())
         return;
-      --to;
+      newArray = inlineArray();
+      newCapacity = _inlineCapacity;
+    }
+    else
+    {
+      newArray = allocate(newCapacity);
     }
+
+    Mover::relocate(newArray, _array, _size);
+    if (_capacity != 0)
+      countReallocation(_size);
+
+    releaseArray(_array, _capacity);
+    _array = newArray;
+    _capacity = newCapacity;
+  }
+  /**
+   * @brief opens a gap at 'from' by shifting [from, _size) one slot right.
+   *        Requires from < _size < _capacity.
+   */
+  void moveElementsRight(size_type from)
+  {
+    assert(from < _size && _size < _capacity);
+
+    Mover::shiftRight(_array, from, _size);
   }
 
-  void moveElementsLeft(size_type from, int jump = 1)
+  /**
+   * @brief shifts [from, _size) 'jump' slots left and destroys
+   *        the 'jump' trailing objects left behind. _size is not updated.
+   */
+  void moveElementsLeft(size_type from, size_type jump = 1)
   {
     if (_size == 0)
       return;
 
-    assert(from - jump >= 0);
-    for (size_type i = from; i <= _size - 1; ++i)
-      _array[i - jump] = _array[i];
-    
+    assert(from >= jump);
+    Mover::shiftLeft(_array, from, _size, jump);
   }
 };
 
-template <typename Type>
-class Vector<Type>::ConstIterator
+/**
+ * @brief random access iterator, a plain pointer to the element. The vector
+ *        it belongs to is consulted only by the checks, which are compiled
+ *        out of release builds (see Checks.h).
+ */
+template <typename Type, typename Policy, typename Allocator>
+class Vector<Type, Policy, Allocator>::ConstIterator
 {
 public:
-  using iterator_category = std::bidirectional_iterator_tag;
+  using iterator_category = std::random_access_iterator_tag;
   using value_type = typename Vector::value_type;
   using difference_type = typename Vector::difference_type;
   using pointer = typename Vector::const_pointer;
   using reference = typename Vector::const_reference;
 
-  explicit ConstIterator() : _elem(nullptr) {}
-  explicit ConstIterator(const_pointer elem, size_type pos, const Vector<Type> *v) : _elem(elem), _position(pos), vec(v) {}
-  ConstIterator(const ConstIterator &other) : _elem(other._elem), _position(other._position), vec(other.vec) {}
+  explicit ConstIterator() : _elem(nullptr), vec(nullptr) {}
+  explicit ConstIterator(const_pointer elem, const Vector *v) : _elem(elem), vec(v) {}
+  ConstIterator(const ConstIterator &other) = default;
+  ConstIterator &operator=(const ConstIterator &other) = default;
 
   reference operator*() const
   {
-    if (_elem == nullptr)
-      throw std::out_of_range("Dereferencing uninitialized iterator");
-    if (_position >= vec->getSize())
-      throw std::out_of_range("Dereferencing end iterator");
-    
-    return *_elem;   
+    if (detail::checked)
+    {
+      if (_elem == nullptr || vec == nullptr)
+        throw std::out_of_range("Dereferencing uninitialized iterator");
+      if (position() >= static_cast<difference_type>(vec->getSize()))
+        throw std::out_of_range("Dereferencing end iterator");
+    }
+
+    return *_elem;
+  }
+
+  pointer operator->() const
+  {
+    return &**this;
+  }
+
+  reference operator[](difference_type d) const
+  {
+    return *(*this + d);
   }
 
   ConstIterator &operator++()
   {
-    if (_position + 1 > vec->getSize())
+    if (detail::checked && position() + 1 > static_cast<difference_type>(vec->getSize()))
       throw std::out_of_range("Incrementing end iterator");
 
-    ++_position;  
     ++_elem;
     return *this;
   }
 
   ConstIterator operator++(int)
   {
-
-    if (_position + 1 > vec->getSize())
-      throw std::out_of_range("Incrementign end iterator");
-
     auto temp = *this;
-
-    ++_position;
-    ++_elem;
+    ++*this;
     return temp;
   }
 
   ConstIterator &operator--()
   {
-    if (_position == 0)
+    if (detail::checked && position() == 0)
       throw std::out_of_range("Decrementing begin iterator");
 
     --_elem;
-    --_position;
     return *this;
   }
 
   ConstIterator operator--(int)
   {
-    if (_position == 0)
-      throw std::out_of_range("Decrementing begin iterator");
-
     auto temp = *this;
-
-    --_position;
-    --_elem;
+    --*this;
     return temp;
   }
 
-  ConstIterator operator+(difference_type d) const
+  ConstIterator &operator+=(difference_type d)
   {
-    if (_position + d > vec->getSize())
-      throw std::out_of_range("Adding to iterator passed the end");
+    if (detail::checked)
+    {
+      if (position() + d > static_cast<difference_type>(vec->getSize()))
+        throw std::out_of_range("Adding to iterator passed the end");
+      if (position() + d < 0)
+        throw std::out_of_range("Substracting iterator pass zero");
+    }
 
-    return ConstIterator(_elem + d, _position + d, vec);
+    _elem += d;
+    return *this;
+  }
+
+  ConstIterator &operator-=(difference_type d)
+  {
+    return *this += -d;
+  }
+
+  ConstIterator operator+(difference_type d) const
+  {
+    auto temp = *this;
+    return temp += d;
   }
 
   ConstIterator operator-(difference_type d) const
   {
-    if (_position - d < 0)
-      throw std::out_of_range("Substracting iterator pass zero");
+    auto temp = *this;
+    return temp -= d;
+  }
 
-    return ConstIterator(_elem - d, _position - d, vec);
+  difference_type operator-(const ConstIterator &other) const
+  {
+    return _elem - other._elem;
   }
 
   bool operator==(const ConstIterator &other) const
@@ -355,25 +873,30 @@ public:
     return !(*this == other);
   }
 
+  bool operator<(const ConstIterator &other) const { return _elem < other._elem; }
+  bool operator>(const ConstIterator &other) const { return other < *this; }
+  bool operator<=(const ConstIterator &other) const { return !(other < *this); }
+  bool operator>=(const ConstIterator &other) const { return !(*this < other); }
+
 protected:
-  size_type _position;
   const_pointer _elem;
-  const Vector<Type> *vec;
+  const Vector *vec;
+
+  difference_type position() const { return _elem - vec->_array; }
 };
 
-template <typename Type>
-class Vector<Type>::Iterator : public Vector<Type>::ConstIterator
+template <typename Type, typename Policy, typename Allocator>
+class Vector<Type, Policy, Allocator>::Iterator : public Vector<Type, Policy, Allocator>::ConstIterator
 {
 public:
   using pointer = typename Vector::pointer;
   using reference = typename Vector::reference;
-  using size_type = typename Vector::size_type;
 
   explicit Iterator() : ConstIterator()
   {
   }
 
-  Iterator(pointer elem, size_type pos, Vector<Type> *v) : ConstIterator(elem, pos, v) {}
+  Iterator(pointer elem, Vector *v) : ConstIterator(elem, v) {}
 
   Iterator(const ConstIterator &other)
       : ConstIterator(other)
@@ -406,6 +929,18 @@ public:
     return result;
   }
 
+  Iterator &operator+=(difference_type d)
+  {
+    ConstIterator::operator+=(d);
+    return *this;
+  }
+
+  Iterator &operator-=(difference_type d)
+  {
+    ConstIterator::operator-=(d);
+    return *this;
+  }
+
   Iterator operator+(difference_type d) const
   {
     return ConstIterator::operator+(d);
@@ -416,13 +951,37 @@ public:
     return ConstIterator::operator-(d);
   }
 
+  using ConstIterator::operator-;
+
   reference operator*() const
   {
     // ugly cast, yet reduces code duplication.
     return const_cast<reference>(ConstIterator::operator*());
   }
+
+  pointer operator->() const
+  {
+    return &**this;
+  }
+
+  reference operator[](difference_type d) const
+  {
+    return *(*this + d);
+  }
 };
 
+namespace pmr
+{
+
+/**
+ * @brief Vector taking its memory from a std::pmr::memory_resource,
+ *        e.g. a monotonic buffer that lives as long as a single request
+ */
+template <typename Type, typename Policy = DefaultGrowthPolicy>
+using Vector = aisdi::Vector<Type, Policy, std::pmr::polymorphic_allocator<Type>>;
+
+} // namespace pmr
+
 } // namespace aisdi
 
 #endif // AISDI_LINEAR_VECTOR_H
@@ -1,115 +1,547 @@
 #include <iostream>
 #include "LinkedList.h"
 #include "Vector.hpp"
-#include <chrono>
+#include "CircularVector.hpp"
+#include "SmallVector.hpp"
+#include "AlignedAllocator.h"
+#include "UnrolledLinkedList.h"
+#include "LockFreeQueue.h"
+#include "Benchmark.h"
+#include "StdAdapter.h"
+#include "PerfCounters.h"
+#include "Baseline.h"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
 
 using namespace std;
 using namespace aisdi;
+using bench::State;
+using bench::doNotOptimize;
+using bench::iteratorAt;
 
+using StdVector = bench::StdAdapter<std::vector<int>>;
+using StdDeque = bench::StdAdapter<std::deque<int>>;
+using StdList = bench::StdAdapter<std::list<int>>;
+
+// allocations made through CountingAllocator, by any container using it
+static std::atomic<std::size_t> allocationCount{0};
+
+// std::allocator counting its allocations, for the containers whose
+// allocations a benchmark reports
+template <typename Type>
+struct CountingAllocator
+{
+	using value_type = Type;
+
+	CountingAllocator() = default;
+	template <typename Other>
+	CountingAllocator(const CountingAllocator<Other> &) {}
+
+	Type *allocate(std::size_t count)
+	{
+		allocationCount.fetch_add(1, std::memory_order_relaxed);
+		return std::allocator<Type>().allocate(count);
+	}
+
+	void deallocate(Type *memory, std::size_t count)
+	{
+		std::allocator<Type>().deallocate(memory, count);
+	}
+
+	template <typename Other>
+	bool operator==(const CountingAllocator<Other> &) const { return true; }
+	template <typename Other>
+	bool operator!=(const CountingAllocator<Other> &) const { return false; }
+};
+
+using CountedVector = Vector<int, DefaultGrowthPolicy, CountingAllocator<int>>;
+using CountedSmallVector = SmallVector<int, 16, DefaultGrowthPolicy, CountingAllocator<int>>;
+using CountedList = LinkedList<int, CountingAllocator<int>>;
+
+// measures 'f' and reports the allocations it made through CountingAllocator
 template <typename Fun>
-auto measureTime(Fun f)
-{
-	auto start = std::chrono::system_clock::now();
-
-	f();
-
-	auto end = std::chrono::system_clock::now();
-	auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
-
-	return elapsed;
-}
-
-
-int main(){
-		
-		Vector<int> v1;
-		v1.insert(v1.begin(), 1);
-		
-		auto appendVector = []{
-			Vector<int> v1;
-			for(int i= 0; i < 100'000; i++)
-				v1.append(i);
-		};
-		
-		auto appendList = []{
-			LinkedList<int> l1;
-			for(int i= 0; i < 100'000; i++)
-				l1.append(i);
-		};
-		
-		cout<<"Appending 100 000 elements to vector took " << measureTime(appendVector).count()<<endl;
-		cout<<"Appending 100 000 elements to list took " << measureTime(appendList).count()<<endl;
-		
-		
-		auto popLastVector = []{
-			Vector<int> v1;
-			for(int i= 0; i < 100'000; i++)
-				v1.append(i);
-				
-			for(int i= 0; i < 100'000; i++)
-				v1.popLast();
-		};
-		
-		auto popLastList = []{
-			LinkedList<int> l1;
-			for(int i= 0; i < 100'000; i++)
-				l1.append(i);
-				
-			for(int i= 0; i < 100'000; i++)
-				l1.append(i);
-		};
-		
-		cout<<"Popping last 100 000 elements from vector took " << measureTime(popLastVector).count()<<endl;
-		cout<<"Popping last  100 000 elements from list took" << measureTime(popLastList).count()<<endl;
-		
-
-		
-		
-
-		
-	
-		
-		auto popFirstVector = []{
-			Vector<int> v1;
-			for(int i= 0; i < 100'000; i++)
-				v1.append(i);
-			for(int i= 0; i < 100'000; i++)
-				v1.popFirst();
-		};
-		
-		auto popFirstList = []{
-			LinkedList<int> l1;
-			for(int i= 0; i < 100'000; i++)
-				l1.append(i);
-			
-			for(int i= 0; i < 100'000; i++)
-				l1.popFirst();
-		};
-		
-		cout<<"Popping fist 100 000 elements from vector took " << measureTime(popFirstVector).count()<<endl;
-		cout<<"Popping first 100 000 elements from list took " << measureTime(popFirstList).count()<<endl;
-		
-		auto popMiddleVector = []{
-			Vector<int> v1;
-			for(int i= 0; i < 100'000; i++)
-				v1.append(i);
-			for(int i= 0; i < 49'000; i++)
-				v1.erase(v1.begin() + 50'000);
-		};
-		
-		auto popMiddleList = []{
-			LinkedList<int> l1;
-			for(int i= 0; i < 100'000; i++)
-				l1.append(i);
-			
-			for(int i= 0; i < 49'000; i++)
-				l1.erase(l1.begin() + 50'000);
-		};
-		
-		cout<<"Popping middle 49 000 elements from vector took " << measureTime(popFirstVector).count()<<endl;
-		cout<<"Popping middle 49 000 elements from list took " << measureTime(popFirstList).count()<<endl;
-		
-		
+void measureCountingAllocations(State &state, Fun f)
+{
+	auto before = allocationCount.load(std::memory_order_relaxed);
+	state.measure(f);
+	state.setCounter("allocations", allocationCount.load(std::memory_order_relaxed) - before);
+}
+
+#if AISDI_LINEAR_INSTRUMENTED
+// counters of the containers over the timed code, see Instrumentation.h
+class AllocationStatsProbe : public bench::Probe
+{
+public:
+	void reset() override
+	{
+		total = AllocationStats();
+	}
+
+	void start() override
+	{
+		resetGlobalAllocationStats();
+	}
+
+	void stop() override
+	{
+		auto stats = globalAllocationStats();
+		total.allocations += stats.allocations;
+		total.frees += stats.frees;
+		total.bytesAllocated += stats.bytesAllocated;
+		total.reallocations += stats.reallocations;
+		total.elementsRelocated += stats.elementsRelocated;
+		total.peakBytes = std::max(total.peakBytes, stats.peakBytes);
+	}
+
+	void report(State &state) override
+	{
+		state.setCounter("aisdi.allocations", total.allocations);
+		state.setCounter("aisdi.frees", total.frees);
+		state.setCounter("aisdi.bytesAllocated", total.bytesAllocated);
+		state.setCounter("aisdi.reallocations", total.reallocations);
+		state.setCounter("aisdi.elementsRelocated", total.elementsRelocated);
+		state.setCounter("aisdi.peakBytes", total.peakBytes);
+	}
+
+private:
+	AllocationStats total;
+};
+#endif
+
+// int wrapper with user-provided copy operations, it is not trivially
+// copyable so Vector has to take the element-wise path for it
+struct NonTrivialInt
+{
+	NonTrivialInt(int v = 0) : value(v) {}
+	NonTrivialInt(const NonTrivialInt &other) : value(other.value) {}
+	NonTrivialInt &operator=(const NonTrivialInt &other)
+	{
+		value = other.value;
+		return *this;
+	}
+
+	int value;
+};
+
+template <typename Collection>
+Collection filledWith(std::size_t size)
+{
+	Collection c1;
+	for(std::size_t i= 0; i < size; i++)
+		c1.append(static_cast<int>(i));
+	return c1;
+}
+
+template <typename Collection>
+void append(State &state)
+{
+	state.measure([&]{
+		Collection c1;
+		for(std::size_t i= 0; i < state.size(); i++)
+			c1.append(static_cast<int>(i));
+		doNotOptimize(c1);
+	});
+}
+
+template <typename Collection>
+void prepend(State &state)
+{
+	state.measure([&]{
+		Collection c1;
+		for(std::size_t i= 0; i < state.size(); i++)
+			c1.prepend(static_cast<int>(i));
+		doNotOptimize(c1);
+	});
+}
+
+template <typename Collection>
+void popFirst(State &state)
+{
+	auto c1 = filledWith<Collection>(state.size());
+	state.measure([&]{
+		for(std::size_t i= 0; i < state.size(); i++)
+			doNotOptimize(c1.popFirst());
+	});
+}
+
+template <typename Collection>
+void popLast(State &state)
+{
+	auto c1 = filledWith<Collection>(state.size());
+	state.measure([&]{
+		for(std::size_t i= 0; i < state.size(); i++)
+			doNotOptimize(c1.popLast());
+	});
+}
+
+template <typename Collection>
+void insertMiddle(State &state)
+{
+	state.measure([&]{
+		Collection c1;
+		for(std::size_t i= 0; i < state.size(); i++)
+			c1.insert(iteratorAt(c1, c1.getSize() / 2), static_cast<int>(i));
+		doNotOptimize(c1);
+	});
+}
+
+// erases half of 2 * size elements, always from the middle
+template <typename Collection>
+void eraseMiddle(State &state)
+{
+	auto c1 = filledWith<Collection>(2 * state.size());
+	state.measure([&]{
+		for(std::size_t i= 0; i < state.size(); i++)
+			c1.erase(iteratorAt(c1, c1.getSize() / 2));
+	});
+}
+
+// the same as eraseMiddle, in one pass
+void eraseIfMiddleVector(State &state)
+{
+	auto v1 = filledWith<Vector<int>>(2 * state.size());
+	const int from = static_cast<int>(state.size() / 2);
+	const int to = from + static_cast<int>(state.size());
+	state.measure([&]{
+		v1.eraseIf([from, to](int value){ return value >= from && value < to; });
+	});
+}
+
+// create-fill-destroy of 'size' vectors of 12 elements, the typical life
+// of a small vector
+template <typename VectorType>
+void createFillDestroy(State &state)
+{
+	measureCountingAllocations(state, [&]{
+		for(std::size_t i= 0; i < state.size(); i++)
+		{
+			VectorType v1;
+			for(int j= 0; j < 12; j++)
+				v1.append(j);
+			doNotOptimize(v1);
+		}
+	});
+}
+
+// one pass summing the collection, filling it is not measured
+template <typename Collection>
+void scan(State &state)
+{
+	auto c1 = filledWith<Collection>(state.size());
+	long long sum = 0;
+	state.measure([&]{
+		for(auto value : c1)
+			sum += value;
+	});
+	doNotOptimize(sum);
+}
+
+template <typename Collection>
+void copy(State &state)
+{
+	const auto c1 = filledWith<Collection>(state.size());
+	std::unique_ptr<Collection> c2;
+	state.measure([&]{
+		c2 = std::make_unique<Collection>(c1);
+		doNotOptimize(*c2);
+	});
+}
+
+// builds a list of 'size' ints and drops it
+void buildDropListByAppending(State &state)
+{
+	measureCountingAllocations(state, [&]{
+		CountedList l1;
+		for(std::size_t i= 0; i < state.size(); i++)
+			l1.append(static_cast<int>(i));
+	});
+}
+
+void buildDropListFromRange(State &state)
+{
+	auto values = filledWith<Vector<int>>(state.size());
+	measureCountingAllocations(state, [&]{
+		CountedList l1(values.begin(), values.end());
+		doNotOptimize(l1);
+	});
+}
+
+
+// ints whose nodes lie in memory in shuffled order: sorting by a hash of the
+// value relinks the nodes without moving them. Built once per size, it takes
+// far longer than scanning it.
+const LinkedList<int> &shuffledList(std::size_t size)
+{
+	static std::map<std::size_t, LinkedList<int>> lists;
+	auto found = lists.find(size);
+	if(found != lists.end())
+		return found->second;
+
+	auto l1 = filledWith<LinkedList<int>>(size);
+	l1.sort([](int a, int b){
+		return (static_cast<unsigned>(a) * 2654435761u) < (static_cast<unsigned>(b) * 2654435761u);
+	});
+	return lists.emplace(size, std::move(l1)).first->second;
+}
+
+// sums the shuffled list through 'scan', which calls its argument per element
+template <typename Scan>
+void scanShuffledList(State &state, Scan scan)
+{
+	const auto &l1 = shuffledList(state.size());
+	long long sum = 0;
+	state.measure([&]{
+		scan(l1, [&sum](int value){ sum += value; });
+	});
+	doNotOptimize(sum);
+}
+
+template <std::size_t Distance>
+void scanShuffledListWithForEach(State &state)
+{
+	scanShuffledList(state, [](const auto &l1, auto fn){ l1.template forEach<Distance>(fn); });
+}
+
+void scanShuffledListWithIterators(State &state)
+{
+	scanShuffledList(state, [](const auto &l1, auto fn){
+		for(auto value : l1)
+			fn(value);
+	});
+}
+
+
+// LinkedList used as a queue between threads, behind a mutex
+class LockedListQueue
+{
+public:
+	void push(int value)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		list.append(value);
+	}
+
+	bool tryPop(int &out)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if(list.isEmpty())
+			return false;
+		out = list.popFirst();
+		return true;
+	}
+
+private:
+	std::mutex mutex;
+	LinkedList<int> list;
+};
+
+// hands 'size' ints over from 'Producers' threads to one consumer
+template <typename Queue, int Producers>
+void handOff(State &state)
+{
+	const int perProducer = static_cast<int>(state.size()) / Producers;
+	state.setOperations(static_cast<std::size_t>(perProducer) * Producers);
+	Queue queue;
+	long long sum = 0;
+
+	state.measure([&]{
+		std::vector<std::thread> threads;
+		for(int p= 0; p < Producers; p++)
+			threads.emplace_back([&queue, perProducer]{
+				for(int i= 0; i < perProducer; i++)
+					queue.push(i);
+			});
+
+		int value;
+		for(int received= 0; received < perProducer * Producers;)
+		{
+			if(!queue.tryPop(value))
+			{
+				std::this_thread::yield();
+				continue;
+			}
+			sum += value;
+			received++;
+		}
+
+		for(auto &thread : threads)
+			thread.join();
+	});
+	doNotOptimize(sum);
+}
+
+
+// time the calling thread spends dropping a collection of 'size' strings,
+// each with its own heap buffer, filling it is not measured
+template <typename Collection, bool Async>
+void dropCollection(State &state)
+{
+	Collection c1;
+	for(std::size_t i= 0; i < state.size(); i++)
+		c1.append(std::string(32, 'x'));
+
+	state.measure([&]{
+		if constexpr (Async)
+			c1.releaseAsync();
+		else
+			c1 = Collection();
+	});
+	BackgroundReclaimer::instance().drain();
+}
+
+
+int main(int argc, char **argv){
+
+		bench::Options options;
+		try
+		{
+			options = bench::Options::parse(argc, argv);
+		}
+		catch(const std::exception &e)
+		{
+			cerr<<e.what()<<endl;
+			cerr<<"usage: "<<argv[0]<<" [name-pattern...] [--sizes=N,M] [--warmup=N] [--repetitions=N] [--json=path | --save-baseline=path] [--compare=path] [--tolerance=percent] [--list] [--perf]"<<endl;
+			return 2;
+		}
+
+		const std::vector<std::size_t> linear = { 1'000, 100'000 };
+		const std::vector<std::size_t> quadratic = { 1'000, 20'000 };
+		const std::vector<std::size_t> large = { 1'000'000 };
+
+		bench::Runner runner;
+#if AISDI_LINEAR_INSTRUMENTED
+		runner.addProbe(std::make_unique<AllocationStatsProbe>());
+#endif
+		if(options.perf && !options.listOnly)
+		{
+			std::string error;
+			if(auto counters = bench::PerfCounters::open(error))
+			{
+				cerr<<"hardware counters:";
+				for(const auto &name : counters->names())
+					cerr<<" "<<name;
+				cerr<<endl;
+				runner.addProbe(std::move(counters));
+			}
+			else
+				cerr<<"hardware counters unavailable ("<<error<<"), timing only"<<endl;
+		}
+
+		// the std:: containers are the baselines of the ratio table
+		runner.add("append/Vector", linear, append<Vector<int>>);
+		runner.add("append/LinkedList", linear, append<LinkedList<int>>);
+		runner.add("append/std::vector", linear, append<StdVector>);
+		runner.add("append/std::deque", linear, append<StdDeque>);
+		runner.add("append/std::list", linear, append<StdList>);
+
+		runner.add("prepend/Vector", quadratic, prepend<Vector<int>>);
+		runner.add("prepend/Vector<NonTrivialInt>", quadratic, prepend<Vector<NonTrivialInt>>);
+		runner.add("prepend/LinkedList", quadratic, prepend<LinkedList<int>>);
+		runner.add("prepend/CircularVector", quadratic, prepend<CircularVector<int>>);
+		runner.add("prepend/std::vector", quadratic, prepend<StdVector>);
+		runner.add("prepend/std::deque", quadratic, prepend<StdDeque>);
+		runner.add("prepend/std::list", quadratic, prepend<StdList>);
+
+		runner.add("popFirst/Vector", linear, popFirst<Vector<int>>);
+		runner.add("popFirst/Vector<NonTrivialInt>", linear, popFirst<Vector<NonTrivialInt>>);
+		runner.add("popFirst/LinkedList", linear, popFirst<LinkedList<int>>);
+		runner.add("popFirst/CircularVector", linear, popFirst<CircularVector<int>>);
+		runner.add("popFirst/std::vector", linear, popFirst<StdVector>);
+		runner.add("popFirst/std::deque", linear, popFirst<StdDeque>);
+		runner.add("popFirst/std::list", linear, popFirst<StdList>);
+
+		runner.add("popLast/Vector", linear, popLast<Vector<int>>);
+		runner.add("popLast/LinkedList", linear, popLast<LinkedList<int>>);
+		runner.add("popLast/std::vector", linear, popLast<StdVector>);
+		runner.add("popLast/std::deque", linear, popLast<StdDeque>);
+		runner.add("popLast/std::list", linear, popLast<StdList>);
+
+		runner.add("insertMiddle/Vector", quadratic, insertMiddle<Vector<int>>);
+		runner.add("insertMiddle/Vector<NonTrivialInt>", quadratic, insertMiddle<Vector<NonTrivialInt>>);
+		runner.add("insertMiddle/LinkedList", quadratic, insertMiddle<LinkedList<int>>);
+		runner.add("insertMiddle/UnrolledLinkedList", quadratic, insertMiddle<UnrolledLinkedList<int>>);
+		runner.add("insertMiddle/IndexedLinkedList", quadratic, insertMiddle<IndexedLinkedList<int>>);
+		runner.add("insertMiddle/std::vector", quadratic, insertMiddle<StdVector>);
+		runner.add("insertMiddle/std::deque", quadratic, insertMiddle<StdDeque>);
+		runner.add("insertMiddle/std::list", quadratic, insertMiddle<StdList>);
+
+		runner.add("eraseMiddle/Vector", quadratic, eraseMiddle<Vector<int>>);
+		runner.add("eraseMiddle/Vector::eraseIf", quadratic, eraseIfMiddleVector);
+		runner.add("eraseMiddle/LinkedList", quadratic, eraseMiddle<LinkedList<int>>);
+		runner.add("eraseMiddle/UnrolledLinkedList", quadratic, eraseMiddle<UnrolledLinkedList<int>>);
+		runner.add("eraseMiddle/IndexedLinkedList", quadratic, eraseMiddle<IndexedLinkedList<int>>);
+		runner.add("eraseMiddle/std::vector", quadratic, eraseMiddle<StdVector>);
+		runner.add("eraseMiddle/std::deque", quadratic, eraseMiddle<StdDeque>);
+		runner.add("eraseMiddle/std::list", quadratic, eraseMiddle<StdList>);
+
+		runner.add("scan/Vector", { 1'000'000, 16'000'000 }, scan<Vector<int>>);
+		runner.add("scan/AlignedVector<64>", { 1'000'000, 16'000'000 }, scan<AlignedVector<int, 64>>);
+		runner.add("scan/HugePageVector", { 1'000'000, 16'000'000 }, scan<HugePageVector<int>>);
+		runner.add("scan/LinkedList", large, scan<LinkedList<int>>);
+		runner.add("scan/UnrolledLinkedList", large, scan<UnrolledLinkedList<int>>);
+		runner.add("scan/CircularVector", large, scan<CircularVector<int>>);
+		runner.add("scan/std::vector", { 1'000'000, 16'000'000 }, scan<StdVector>);
+		runner.add("scan/std::deque", large, scan<StdDeque>);
+		runner.add("scan/std::list", large, scan<StdList>);
+
+		runner.add("copy/Vector", linear, copy<Vector<int>>);
+		runner.add("copy/LinkedList", linear, copy<LinkedList<int>>);
+		runner.add("copy/CircularVector", linear, copy<CircularVector<int>>);
+		runner.add("copy/std::vector", linear, copy<StdVector>);
+		runner.add("copy/std::deque", linear, copy<StdDeque>);
+		runner.add("copy/std::list", linear, copy<StdList>);
+
+		runner.add("createFillDestroy12/Vector", large, createFillDestroy<CountedVector>);
+		runner.add("createFillDestroy12/SmallVector<16>", large, createFillDestroy<CountedSmallVector>);
+
+		runner.add("buildDrop/LinkedList::append", { 100'000 }, buildDropListByAppending);
+		runner.add("buildDrop/LinkedList(range)", { 100'000 }, buildDropListFromRange);
+
+		runner.add("scanShuffled/LinkedList::iterator", large, scanShuffledListWithIterators);
+		runner.add("scanShuffled/LinkedList::forEach<0>", large, scanShuffledListWithForEach<0>);
+		runner.add("scanShuffled/LinkedList::forEach<8>", large, scanShuffledListWithForEach<8>);
+		runner.add("scanShuffled/LinkedList::forEach<32>", large, scanShuffledListWithForEach<32>);
+
+		// threads make these depend on scheduling, the baseline check allows more
+		const double scheduled = 0.5;
+		runner.add("handOff1/LockedListQueue", large, handOff<LockedListQueue, 1>, scheduled);
+		runner.add("handOff1/SpscQueue", large, handOff<SpscQueue<int>, 1>, scheduled);
+		runner.add("handOff1/MpscQueue", large, handOff<MpscQueue<int>, 1>, scheduled);
+		runner.add("handOff4/LockedListQueue", large, handOff<LockedListQueue, 4>, scheduled);
+		runner.add("handOff4/MpscQueue", large, handOff<MpscQueue<int>, 4>, scheduled);
+
+		runner.add("drop/LinkedList<string>", large, dropCollection<LinkedList<string>, false>);
+		runner.add("drop/LinkedList<string>::releaseAsync", large, dropCollection<LinkedList<string>, true>, scheduled);
+		runner.add("drop/Vector<string>", large, dropCollection<Vector<string>, false>);
+		runner.add("drop/Vector<string>::releaseAsync", large, dropCollection<Vector<string>, true>, scheduled);
+
+		try
+		{
+			// loaded up front, a missing baseline fails before the long run
+			std::optional<bench::Baseline> baseline;
+			if(!options.comparePath.empty() && !options.listOnly)
+				baseline = bench::Baseline::load(options.comparePath);
+
+			auto results = runner.run(options);
+			if(baseline && !baseline->check(results))
+				return 1;
+		}
+		catch(const std::exception &e)
+		{
+			cerr<<e.what()<<endl;
+			return 1;
+		}
+
 		return 0;
-		
+
 }
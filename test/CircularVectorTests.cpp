@@ -0,0 +1,87 @@
+#include "../src/CircularVector.hpp"
+#include "OperationCountingObject.h"
+
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::CircularVector<T>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(CircularVectorTests, Fixture)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenWrappedCollection_WhenIterating_ThenItemsAreInLogicalOrder,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 3, 4, 5, 6 };
+  collection.prepend(2);
+  collection.prepend(1);
+  collection.popLast();
+  collection.append(7);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5, 7 });
+  BOOST_CHECK_EQUAL(collection[0], 1);
+  BOOST_CHECK_EQUAL(collection[5], 7);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionUsedAsQueue_WhenPoppingFirst_ThenCapacityDoesNotGrow,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection;
+  for (int i = 0; i < 6; ++i)
+    collection.append(i);
+
+  for (int i = 6; i < 1000; ++i)
+  {
+    collection.append(i);
+    BOOST_CHECK_EQUAL(collection.popFirst(), i - 6);
+  }
+
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 8);
+  thenCollectionContainsValues(collection, { 994, 995, 996, 997, 998, 999 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenWrappedCollection_WhenInsertingAndErasingInMiddle_ThenOrderIsPreserved,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 5, 6, 7, 8 };
+  collection.prepend(4);
+  collection.prepend(3);
+
+  collection.insert(begin(collection) + 1, 100);
+  collection.insert(begin(collection) + 5, 200);
+  thenCollectionContainsValues(collection, { 3, 100, 4, 5, 6, 200, 7, 8 });
+
+  collection.erase(begin(collection) + 1);
+  collection.erase(begin(collection) + 4, begin(collection) + 6);
+  thenCollectionContainsValues(collection, { 3, 4, 5, 6, 8 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterators_WhenUsingRandomAccess_ThenPositionsAreComputed,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 10, 20, 30, 40 };
+  collection.prepend(0);
+
+  auto it = begin(collection);
+  it += 3;
+
+  BOOST_CHECK_EQUAL(*it, 30);
+  BOOST_CHECK_EQUAL(it[1], 40);
+  BOOST_CHECK_EQUAL(end(collection) - it, 2);
+  BOOST_CHECK(begin(collection) < it);
+  BOOST_CHECK_THROW(it += 3, std::out_of_range);
+}
+
+// ConstIterator is tested via Iterator methods.
+// If Iterator methods are to be changed, then new ConstIterator tests are required.
+
+BOOST_AUTO_TEST_SUITE_END()
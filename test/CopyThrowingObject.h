@@ -0,0 +1,24 @@
+#ifndef AISDI_LINEAR_TEST_COPYTHROWINGOBJECT_H
+#define AISDI_LINEAR_TEST_COPYTHROWINGOBJECT_H
+
+#include <stdexcept>
+
+// its copy throws once armed, and as its move is not noexcept either,
+// containers that must not lose elements copy it
+struct CopyThrowingObject
+{
+  static inline bool armed = false;
+
+  CopyThrowingObject(int value_ = 0) : value(value_) {}
+  CopyThrowingObject(const CopyThrowingObject& other) : value(other.value)
+  {
+    if (armed)
+      throw std::runtime_error("copy");
+  }
+  CopyThrowingObject(CopyThrowingObject&& other) : value(other.value) {}
+  CopyThrowingObject& operator=(const CopyThrowingObject&) = default;
+
+  int value;
+};
+
+#endif // AISDI_LINEAR_TEST_COPYTHROWINGOBJECT_H
@@ -0,0 +1,34 @@
+#ifndef AISDI_LINEAR_TEST_COUNTINGRESOURCE_H
+#define AISDI_LINEAR_TEST_COUNTINGRESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+// memory resource counting what goes through it, backed by new/delete
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+  std::size_t allocations = 0;
+  std::size_t bytesInUse = 0;
+
+private:
+  void *do_allocate(std::size_t bytes, std::size_t alignment) override
+  {
+    ++allocations;
+    bytesInUse += bytes;
+    return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override
+  {
+    bytesInUse -= bytes;
+    std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+  {
+    return this == &other;
+  }
+};
+
+#endif // AISDI_LINEAR_TEST_COUNTINGRESOURCE_H
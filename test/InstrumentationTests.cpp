@@ -0,0 +1,148 @@
+#include "../src/Vector.hpp"
+#include "../src/LinkedList.h"
+
+#include <cstddef>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+static_assert(aisdi::detail::instrumented, "The tests are built with AISDI_LINEAR_INSTRUMENTED=1");
+
+BOOST_AUTO_TEST_SUITE(InstrumentationTests)
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenAppending_ThenReallocationsAreCounted)
+{
+  aisdi::Vector<int> collection;
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
+
+  // capacities 8, 16, 32, 64 and 128
+  const auto stats = collection.getAllocationStats();
+  BOOST_CHECK_EQUAL(stats.allocations, 5);
+  BOOST_CHECK_EQUAL(stats.frees, 4);
+  BOOST_CHECK_EQUAL(stats.reallocations, 4);
+  BOOST_CHECK_EQUAL(stats.elementsRelocated, 8 + 16 + 32 + 64);
+  BOOST_CHECK_EQUAL(stats.bytesAllocated, (8 + 16 + 32 + 64 + 128) * sizeof(int));
+  BOOST_CHECK_EQUAL(stats.bytesInUse, 128 * sizeof(int));
+  // both buffers are held while the elements move over
+  BOOST_CHECK_EQUAL(stats.peakBytes, (64 + 128) * sizeof(int));
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenCopied_ThenCopyCountsFromZero)
+{
+  aisdi::Vector<int> collection;
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
+
+  const aisdi::Vector<int> copy(collection);
+
+  const auto stats = copy.getAllocationStats();
+  BOOST_CHECK_EQUAL(stats.allocations, 1);
+  BOOST_CHECK_EQUAL(stats.reallocations, 0);
+  BOOST_CHECK_EQUAL(stats.bytesInUse, 100 * sizeof(int));
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenMoved_ThenBufferGoesOverWithoutAllocating)
+{
+  aisdi::Vector<int> collection = { 1, 2, 3, 4 };
+
+  aisdi::Vector<int> moved(std::move(collection));
+
+  BOOST_CHECK_EQUAL(moved.getAllocationStats().allocations, 0);
+  BOOST_CHECK_EQUAL(moved.getAllocationStats().bytesInUse, 4 * sizeof(int));
+  BOOST_CHECK_EQUAL(collection.getAllocationStats().bytesInUse, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenVector_WhenReleasingAsynchronously_ThenBufferIsFreedOnHandOver)
+{
+  aisdi::Vector<int> collection = { 1, 2, 3, 4 };
+
+  collection.releaseAsync();
+
+  BOOST_CHECK_EQUAL(collection.getAllocationStats().frees, 1);
+  BOOST_CHECK_EQUAL(collection.getAllocationStats().bytesInUse, 0);
+  aisdi::BackgroundReclaimer::instance().drain();
+}
+
+BOOST_AUTO_TEST_CASE(GivenList_WhenAddingAndRemoving_ThenNodesAreCounted)
+{
+  aisdi::LinkedList<int> collection;
+  for (int i = 0; i < 10; ++i)
+    collection.append(i);
+  collection.insert(collection.begin(), -1);
+  collection.popFirst();
+  collection.popLast();
+
+  const auto stats = collection.getAllocationStats();
+  const auto nodeSize = stats.bytesAllocated / stats.allocations;
+  // the guard is a node too
+  BOOST_CHECK_EQUAL(stats.allocations, 12);
+  BOOST_CHECK_EQUAL(stats.frees, 2);
+  BOOST_CHECK_EQUAL(stats.reallocations, 0);
+  BOOST_CHECK_EQUAL(stats.bytesInUse, 10 * nodeSize);
+  BOOST_CHECK_EQUAL(stats.peakBytes, 12 * nodeSize);
+}
+
+BOOST_AUTO_TEST_CASE(GivenList_WhenCleared_ThenAllNodesButGuardAreFreed)
+{
+  aisdi::LinkedList<int> collection = { 1, 2, 3, 4 };
+
+  collection.clear();
+
+  const auto stats = collection.getAllocationStats();
+  BOOST_CHECK_EQUAL(stats.frees, 4);
+  BOOST_CHECK_EQUAL(stats.bytesInUse, stats.bytesAllocated / 5);
+}
+
+BOOST_AUTO_TEST_CASE(GivenTwoLists_WhenSplicing_ThenNodesGoOverWithoutAllocating)
+{
+  aisdi::LinkedList<int> collection = { 1, 2 };
+  aisdi::LinkedList<int> other = { 3, 4, 5 };
+  const auto nodeSize = other.getAllocationStats().bytesAllocated / 4;
+
+  collection.splice(collection.end(), other);
+  auto tail = collection.splitAt(collection.begin() + 1);
+
+  BOOST_CHECK_EQUAL(collection.getAllocationStats().allocations, 3);
+  BOOST_CHECK_EQUAL(collection.getAllocationStats().bytesInUse, 2 * nodeSize);
+  BOOST_CHECK_EQUAL(other.getAllocationStats().bytesInUse, nodeSize);
+  BOOST_CHECK_EQUAL(tail.getAllocationStats().allocations, 1);
+  BOOST_CHECK_EQUAL(tail.getAllocationStats().bytesInUse, 5 * nodeSize);
+}
+
+BOOST_AUTO_TEST_CASE(GivenList_WhenMoveAssigned_ThenNodesGoOverWithoutAllocating)
+{
+  aisdi::LinkedList<int> collection = { 1 };
+  aisdi::LinkedList<int> other = { 2, 3, 4 };
+  const auto nodeSize = other.getAllocationStats().bytesAllocated / 4;
+
+  collection = std::move(other);
+
+  BOOST_CHECK_EQUAL(collection.getAllocationStats().allocations, 2);
+  BOOST_CHECK_EQUAL(collection.getAllocationStats().bytesInUse, 4 * nodeSize);
+  BOOST_CHECK_EQUAL(other.getAllocationStats().bytesInUse, nodeSize);
+}
+
+BOOST_AUTO_TEST_CASE(GivenContainers_WhenDestroyed_ThenGlobalCountersBalance)
+{
+  aisdi::resetGlobalAllocationStats();
+  const auto before = aisdi::globalAllocationStats();
+  {
+    aisdi::Vector<int> vector;
+    for (int i = 0; i < 100; ++i)
+      vector.append(i);
+    aisdi::LinkedList<int> list;
+    for (int i = 0; i < 10; ++i)
+      list.append(i);
+  }
+
+  const auto after = aisdi::globalAllocationStats();
+  BOOST_CHECK_EQUAL(after.allocations, 5 + 11);
+  BOOST_CHECK_EQUAL(after.frees, 5 + 11);
+  BOOST_CHECK_EQUAL(after.reallocations, 4);
+  BOOST_CHECK_EQUAL(after.bytesInUse, before.bytesInUse);
+  BOOST_CHECK_GE(after.peakBytes, before.bytesInUse + 128 * sizeof(int));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
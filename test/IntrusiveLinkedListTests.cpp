@@ -0,0 +1,237 @@
+#include "../src/IntrusiveLinkedList.h"
+
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+namespace
+{
+
+// no default constructor, the list must not need one
+struct Item
+{
+  explicit Item(int value_) : value(value_) {}
+
+  int value;
+  aisdi::IntrusiveListHook hook;
+  aisdi::IntrusiveListHook otherHook;
+};
+
+using Collection = aisdi::IntrusiveLinkedList<Item, &Item::hook>;
+using OtherCollection = aisdi::IntrusiveLinkedList<Item, &Item::otherHook>;
+
+template <typename List>
+void thenCollectionContainsValues(const List& collection, std::initializer_list<int> expected)
+{
+  std::vector<int> values;
+  for (const auto& item : collection)
+    values.push_back(item.value);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(values.begin(), values.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(collection.getSize(), expected.size());
+}
+
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(IntrusiveLinkedListTests)
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty)
+{
+  const Collection collection;
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(collection.begin() == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE(GivenObjects_WhenLinking_ThenTheyAreInCollectionInOrder)
+{
+  Item a(1), b(2), c(3), d(4);
+  Collection collection;
+
+  collection.append(b);
+  collection.prepend(a);
+  collection.append(d);
+  collection.insert(collection.iteratorTo(d), c);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+  BOOST_CHECK(a.hook.isLinked());
+  BOOST_CHECK(!a.otherHook.isLinked());
+  BOOST_CHECK_EQUAL(&*collection.begin(), &a);
+  BOOST_CHECK_EQUAL(collection.begin()->value, 1);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenErasingByReference_ThenObjectIsUnlinked)
+{
+  Item a(1), b(2), c(3);
+  Collection collection;
+  collection.append(a);
+  collection.append(b);
+  collection.append(c);
+
+  collection.erase(b);
+
+  thenCollectionContainsValues(collection, { 1, 3 });
+  BOOST_CHECK(!b.hook.isLinked());
+  BOOST_CHECK_THROW(collection.erase(b), std::out_of_range);
+
+  collection.append(b);
+  thenCollectionContainsValues(collection, { 1, 3, 2 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenObjectOfAnotherCollection_WhenErasingByReference_ThenOperationThrows)
+{
+  Item a(1), b(2);
+  Collection collection, other;
+  collection.append(a);
+  other.append(b);
+  Collection moved(std::move(other));
+
+  BOOST_CHECK_THROW(collection.erase(b), std::out_of_range);
+  BOOST_CHECK_THROW(other.erase(b), std::out_of_range);
+
+  thenCollectionContainsValues(collection, { 1 });
+  thenCollectionContainsValues(moved, { 2 });
+  moved.erase(b);
+  BOOST_CHECK(moved.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenErasingByIterator_ThenObjectIsUnlinked)
+{
+  Item a(1), b(2);
+  Collection collection;
+  collection.append(a);
+  collection.append(b);
+
+  collection.erase(collection.begin());
+
+  thenCollectionContainsValues(collection, { 2 });
+  BOOST_CHECK(!a.hook.isLinked());
+  BOOST_CHECK_THROW(collection.erase(collection.end()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenPopping_ThenObjectsAreReturned)
+{
+  Item a(1), b(2), c(3);
+  Collection collection;
+  collection.append(a);
+  collection.append(b);
+  collection.append(c);
+
+  BOOST_CHECK_EQUAL(&collection.popFirst(), &a);
+  BOOST_CHECK_EQUAL(&collection.popLast(), &c);
+
+  thenCollectionContainsValues(collection, { 2 });
+  collection.popLast();
+  BOOST_CHECK_THROW(collection.popFirst(), std::out_of_range);
+  BOOST_CHECK_THROW(collection.popLast(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE(GivenLinkedObject_WhenLinkingAgain_ThenOperationThrows)
+{
+  Item a(1);
+  Collection collection, other;
+  collection.append(a);
+
+  BOOST_CHECK_THROW(collection.append(a), std::logic_error);
+  BOOST_CHECK_THROW(other.prepend(a), std::logic_error);
+  thenCollectionContainsValues(collection, { 1 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenObjectWithTwoHooks_WhenLinkedIntoTwoCollections_ThenEachKeepsOwnOrder)
+{
+  Item a(1), b(2), c(3);
+  Collection collection;
+  OtherCollection other;
+
+  collection.append(a);
+  collection.append(b);
+  collection.append(c);
+  other.prepend(a);
+  other.prepend(b);
+  other.prepend(c);
+  collection.erase(b);
+
+  thenCollectionContainsValues(collection, { 1, 3 });
+  thenCollectionContainsValues(other, { 3, 2, 1 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenIterating_ThenItMovesBothWaysAndChecksEnds)
+{
+  Item a(1), b(2);
+  Collection collection;
+  collection.append(a);
+  collection.append(b);
+
+  auto it = collection.end();
+  --it;
+  BOOST_CHECK_EQUAL(it->value, 2);
+  it--;
+  BOOST_CHECK_EQUAL((*it).value, 1);
+  BOOST_CHECK_THROW(--it, std::out_of_range);
+  BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
+  BOOST_CHECK_THROW(++collection.end(), std::out_of_range);
+
+  (*it).value = 10;
+  BOOST_CHECK_EQUAL(a.value, 10);
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenMoving_ThenObjectsChangeCollection)
+{
+  Item a(1), b(2), c(3);
+  Collection collection;
+  collection.append(a);
+  collection.append(b);
+
+  Collection moved(std::move(collection));
+  Collection assigned;
+  assigned.append(c);
+  assigned = std::move(moved);
+
+  thenCollectionContainsValues(assigned, { 1, 2 });
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(moved.isEmpty());
+  BOOST_CHECK(!c.hook.isLinked());
+
+  assigned.append(c);
+  thenCollectionContainsValues(assigned, { 1, 2, 3 });
+}
+
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenDestroyedOrCleared_ThenObjectsAreUnlinked)
+{
+  Item a(1), b(2);
+  {
+    Collection collection;
+    collection.append(a);
+    collection.append(b);
+  }
+  BOOST_CHECK(!a.hook.isLinked());
+  BOOST_CHECK(!b.hook.isLinked());
+
+  Collection collection;
+  collection.append(a);
+  collection.clear();
+  BOOST_CHECK(!a.hook.isLinked());
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenLinkedObject_WhenCopying_ThenCopyIsNotLinked)
+{
+  Item a(1);
+  Collection collection;
+  collection.append(a);
+
+  Item copy(a);
+  Item assigned(2);
+  assigned = a;
+
+  BOOST_CHECK(!copy.hook.isLinked());
+  BOOST_CHECK(!assigned.hook.isLinked());
+  BOOST_CHECK_EQUAL(assigned.value, 1);
+  thenCollectionContainsValues(collection, { 1 });
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,997 @@
+#include "../src/Vector.hpp"
+#include "../src/CircularVector.hpp"
+#include "../src/SmallVector.hpp"
+#include "../src/LinkedList.h"
+#include "../src/UnrolledLinkedList.h"
+#include "CopyThrowingObject.h"
+#include "OperationCountingObject.h"
+
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/joint_view.hpp>
+#include <boost/mpl/list.hpp>
+#include <boost/mpl/transform_view.hpp>
+
+// the cases every container passes, run over each of them with each of
+// TestedTypes; the suites of the containers keep what is specific to them
+
+namespace
+{
+
+struct NoDefault
+{
+  explicit NoDefault(int v) : value(v) {}
+  int value;
+};
+
+template <typename T>
+using VectorOf = aisdi::Vector<T>;
+
+template <typename T>
+using CircularVectorOf = aisdi::CircularVector<T>;
+
+// small inline capacity, so that the cases exercise both storages
+template <typename T>
+using SmallVectorOf = aisdi::SmallVector<T, 2>;
+
+template <typename T>
+using LinkedListOf = aisdi::LinkedList<T>;
+
+// a few elements per node, so that the cases cross node boundaries
+template <typename T>
+using UnrolledLinkedListOf = aisdi::UnrolledLinkedList<T, 4>;
+
+template <template <typename> class Collection>
+struct Of
+{
+  template <typename T>
+  struct apply
+  {
+    using type = Collection<T>;
+  };
+};
+
+template <template <typename> class Collection>
+using CollectionsOf = boost::mpl::transform_view<TestedTypes, Of<Collection>>;
+
+} // namespace
+
+using TestedCollections =
+    boost::mpl::joint_view<CollectionsOf<VectorOf>,
+    boost::mpl::joint_view<CollectionsOf<CircularVectorOf>,
+    boost::mpl::joint_view<CollectionsOf<SmallVectorOf>,
+    boost::mpl::joint_view<CollectionsOf<LinkedListOf>,
+                           CollectionsOf<UnrolledLinkedListOf>>>>>;
+
+// the ones moving their elements over to a larger buffer as they grow
+using GrowingCollections =
+    boost::mpl::joint_view<CollectionsOf<VectorOf>,
+    boost::mpl::joint_view<CollectionsOf<CircularVectorOf>,
+                           CollectionsOf<SmallVectorOf>>>;
+
+using CopyThrowingCollections = boost::mpl::list<VectorOf<CopyThrowingObject>,
+                                                 CircularVectorOf<CopyThrowingObject>,
+                                                 SmallVectorOf<CopyThrowingObject>>;
+
+using NoDefaultCollections = boost::mpl::list<VectorOf<NoDefault>,
+                                              CircularVectorOf<NoDefault>,
+                                              SmallVectorOf<NoDefault>>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(LinearCollectionTests, Fixture)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  const Collection collection;
+
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAddingItem_ThenItIsNoLongerEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection;
+
+  collection.append(T{});
+
+  BOOST_CHECK(!collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenGettingIterators_ThenBeginEqualsEnd,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  BOOST_CHECK(begin(collection) == end(collection));
+  BOOST_CHECK(const_cast<const Collection&>(collection).begin() == collection.end());
+  BOOST_CHECK(collection.cbegin() == collection.cend());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenGettingIterator_ThenBeginIsNotEnd,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection;
+  collection.append(T{});
+
+  BOOST_CHECK(collection.begin() != collection.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithOneElement_WhenIterating_ThenElementIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+  collection.append(753);
+
+  auto it = collection.begin();
+
+  BOOST_CHECK_EQUAL(*it, 753);
+  BOOST_CHECK(++it == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostIncrementing_ThenPreviousPositionIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection;
+  collection.append(T{});
+
+  auto it = collection.begin();
+  auto postIncrementedIt = it++;
+
+  BOOST_CHECK(postIncrementedIt == collection.begin());
+  BOOST_CHECK(it == collection.end());
+  BOOST_CHECK(postIncrementedIt == collection.cbegin());
+  BOOST_CHECK(it == collection.cend());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreIncrementing_ThenNewPositionIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection;
+  collection.append(T{});
+
+  auto it = collection.begin();
+  auto preIncrementedIt = ++it;
+
+  BOOST_CHECK(preIncrementedIt == it);
+  BOOST_CHECK(it == collection.end());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenIncrementing_ThenOperationThrows,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  BOOST_CHECK_THROW(collection.end()++, std::out_of_range);
+  BOOST_CHECK_THROW(++(collection.end()), std::out_of_range);
+  BOOST_CHECK_THROW(collection.cend()++, std::out_of_range);
+  BOOST_CHECK_THROW(++(collection.cend()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDecrementing_ThenIteratorPointsToLastItem,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+  collection.append(1);
+  collection.append(2);
+
+  auto it = collection.end();
+  --it;
+
+  BOOST_CHECK_EQUAL(*it, 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreDecrementing_ThenNewIteratorValueIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+  collection.append(1);
+
+  auto it = collection.end();
+  auto preDecremented = --it;
+
+  BOOST_CHECK(it == preDecremented);
+  BOOST_CHECK_EQUAL(*it, 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostDecrementing_ThenOldIteratorValueIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+  collection.append(1);
+
+  auto it = collection.end();
+  auto postDecremented = it--;
+
+  BOOST_CHECK(postDecremented == collection.end());
+  BOOST_CHECK_EQUAL(*it, 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBeginIterator_WhenDecrementing_ThenOperationThrows,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  BOOST_CHECK_THROW(collection.begin()--, std::out_of_range);
+  BOOST_CHECK_THROW(--(collection.begin()), std::out_of_range);
+  BOOST_CHECK_THROW(collection.cbegin()--, std::out_of_range);
+  BOOST_CHECK_THROW(--(collection.cbegin()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDereferencing_ThenOperationThrows,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
+  BOOST_CHECK_THROW(*collection.cend(), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenConstIterator_WhenDereferencing_ThenItemIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 10, 20, 30 };
+
+  auto it = ++collection.cbegin();
+
+  BOOST_CHECK_EQUAL(*it, 20);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenDereferencing_ThenItemCanBeChanged,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 10, 20, 30 };
+
+  auto it = ++begin(collection);
+  *it = 500;
+
+  thenCollectionContainsValues(collection, { 10, 500, 30 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenAddingInteger_ThenAdvancedIteratorIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 2001, 2010, 2051 };
+
+  auto it = begin(collection);
+
+  BOOST_CHECK(it + 3 == end(collection));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenSubstractingInteger_ThenChangedIteratorIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 2001, 2010, 2051 };
+
+  auto it = end(collection);
+
+  BOOST_CHECK(it - 2 == ++begin(collection));
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAddingItem_ThenItemIsInCollection,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  collection.append(42);
+
+  thenCollectionContainsValues(collection, { 42 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenInitializingFromList_ThenAllItemsAreInCollection,
+                              Collection,
+                              TestedCollections)
+{
+  const Collection collection = { 1410, 753, 1789 };
+
+  thenCollectionContainsValues(collection, { 1410, 753, 1789 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenCreatingCopy_ThenAllItemsAreCopied,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 1410, 753, 1789 };
+  Collection other{collection};
+
+  collection.append(1024);
+
+  thenCollectionContainsValues(collection, { 1410, 753, 1789, 1024 });
+  thenCollectionContainsValues(other, { 1410, 753, 1789 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenCreatingCopy_ThenBothCollectionsAreEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+  Collection other{collection};
+
+  BOOST_CHECK(other.isEmpty());
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMovingToOther_ThenAllItemsAreMoved,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection = { 1410, 753, 1789 };
+
+  OperationCountingObject::resetCounters();
+  Collection other{std::move(collection)};
+
+  thenCollectionContainsValues(other, { 1410, 753, 1789 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 0);
+  thenConstructedObjectsCountWas<T>(0);
+  thenCopiedObjectsCountWas<T>(0);
+  thenAssignedObjectsCountWas<T>(0);
+  thenMovedObjectsCountWas<T>(0);
+  thenDestroyedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMovingToOther_ThenSecondCollectionsIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+  Collection other{std::move(collection)};
+
+  BOOST_CHECK(other.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenAssigningToOther_ThenAllElementsAreCopied,
+                              Collection,
+                              TestedCollections)
+{
+  const Collection collection = { 1, 2, 3, 4 };
+  Collection other = { 100, 200, 300, 400 };
+
+  other = collection;
+
+  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAssigningToOther_ThenOtherCollectionIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  const Collection collection;
+  Collection other = { 100, 200, 300, 400 };
+
+  other = collection;
+
+  BOOST_CHECK(other.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  collection = collection;
+
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 100, 200, 300, 400 };
+
+  collection = collection;
+
+  thenCollectionContainsValues(collection, { 100, 200, 300, 400 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMoveAssigning_ThenAllElementsAreMoved,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection = { 1, 2, 3, 4 };
+  Collection other = { 100, 200, 300, 400 };
+
+  OperationCountingObject::resetCounters();
+  other = std::move(collection);
+
+  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
+  thenConstructedObjectsCountWas<T>(0);
+  thenCopiedObjectsCountWas<T>(0);
+  thenAssignedObjectsCountWas<T>(0);
+  thenMovedObjectsCountWas<T>(0);
+  thenDestroyedObjectsCountWas<T>(4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMoveAssigning_ThenNewCollectionIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+  Collection other = { 100, 200, 300, 400 };
+
+  other = std::move(collection);
+
+  BOOST_CHECK(other.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppendingItem_ThenItemIsLast,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 1, 2, 3 };
+
+  collection.append(42);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 42 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPrependingItem_ThenItemIsAdded,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  collection.prepend(300);
+
+  thenCollectionContainsValues(collection, { 300 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPrependingItem_ThenItemIsFirst,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 1, 2 };
+
+  collection.prepend(300);
+
+  thenCollectionContainsValues(collection, { 300, 1, 2 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenGettingSize_ThenZeroIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  const Collection collection;
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenGettingSize_ThenElementCountIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  const Collection collection = { 12, 100, 500 };
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenChangingIt_ThenItsSizeAlsoChanges,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 72, 27, 77 };
+  collection.append(99);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPrependingItem_ThenSizeIsUpdated,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 72, 27, 77 };
+  collection.prepend(99);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenInsertingItem_ThenItemIsAdded,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  collection.insert(begin(collection), 42);
+
+  thenCollectionContainsValues(collection, { 42 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAtBegin_ThenItemIsPrepended,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 11, 12, 13 };
+
+  collection.insert(begin(collection), 42);
+
+  thenCollectionContainsValues(collection, { 42, 11, 12, 13 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAtEnd_ThenItemIsAppended,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 11, 12, 13 };
+
+  collection.insert(end(collection), 42);
+
+  thenCollectionContainsValues(collection, { 11, 12, 13, 42 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingInMiddle_ThenItemInserted,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 11, 12, 13 };
+
+  collection.insert(++begin(collection), 42);
+
+  thenCollectionContainsValues(collection, { 11, 42, 12, 13 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInserting_ThenSizeIsUpdated,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 101, 102, 103 };
+
+  collection.insert(begin(collection), 27);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 4);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingFirst_ThenOperationThrows,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingLast_ThenOperationThrows,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenPoppingFirst_ThenCollectionIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 420 };
+
+  collection.popFirst();
+
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenPoppingLast_ThenCollectionIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 420 };
+
+  collection.popLast();
+
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenCollectionSizeIsReduced,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 14, 10 };
+
+  collection.popFirst();
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenCollectionSizeIsReduced,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 14, 10 };
+
+  collection.popLast();
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenItemIsRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 300, 8, 480 };
+
+  collection.popFirst();
+
+  thenCollectionContainsValues(collection, { 8, 480 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenItemIsRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 300, 8, 480 };
+
+  collection.popLast();
+
+  thenCollectionContainsValues(collection, { 300, 8 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenItemsIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 101, 202, 303 };
+
+  BOOST_CHECK_EQUAL(collection.popFirst(), 101);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenItemsIsReturned,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 101, 202, 303 };
+
+  BOOST_CHECK_EQUAL(collection.popLast(), 303);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenErasing_ThenOperationThrows,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection;
+
+  BOOST_CHECK_THROW(collection.erase(collection.begin()), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingEnd_ThenOperationThrows,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 20, 16 };
+
+  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingBegin_ThenItemIsRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 22, 41, 31 };
+
+  collection.erase(begin(collection));
+
+  thenCollectionContainsValues(collection, { 41, 31 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingLastItem_ThemItemIsRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 22, 45, 33 };
+
+  collection.erase(--end(collection));
+
+  thenCollectionContainsValues(collection, { 22, 45 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingMiddleItem_ThenItemIsRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 22, 51, 48 };
+
+  collection.erase(++begin(collection));
+
+  thenCollectionContainsValues(collection, { 22, 48 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasing_ThenSizeIsReduced,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 1000, 500, 2, 900 };
+
+  collection.erase(begin(collection) + 2);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenErasing_ThenCollectionIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 1529 };
+
+  collection.erase(begin(collection));
+
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingEmptyRange_ThenNothingHappens,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 19, 42, 11 };
+
+  collection.erase(begin(collection), begin(collection));
+
+  thenCollectionContainsValues(collection, { 19, 42, 11 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRangeFromBegin_ThenItemsAreRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 19, 42, 11 };
+
+  collection.erase(begin(collection), begin(collection) + 2);
+
+  thenCollectionContainsValues(collection, { 11 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_whenErasingRangeToEnd_ThenItemsAreRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 20, 1, 45 };
+
+  collection.erase(begin(collection) + 1, end(collection));
+
+  thenCollectionContainsValues(collection, { 20 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingSingleItemRange_ThenItemIsRemoved,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 2001, 2010, 2051, 3001 };
+
+  collection.erase(begin(collection) + 1, begin(collection) + 2);
+
+  thenCollectionContainsValues(collection, { 2001, 2051, 3001 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingWholeRange_ThenCollectinIsEmpty,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 400, 403, 404 };
+
+  collection.erase(begin(collection), end(collection));
+
+  BOOST_CHECK(collection.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeIsUpdated,
+                              Collection,
+                              TestedCollections)
+{
+  Collection collection = { 23, 10, 20, 16 };
+
+  collection.erase(begin(collection) + 1, end(collection) - 1);
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAppendingItem_ThenOnlyThatItemIsConstructed,
+                              Collection,
+                              GrowingCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection;
+  const T item = 42;
+
+  OperationCountingObject::resetCounters();
+  collection.append(item);
+
+  thenCollectionContainsValues(collection, { 42 });
+  thenConstructedObjectsCountWas<T>(1);
+  thenCopiedObjectsCountWas<T>(1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullCollection_WhenAppendingItem_ThenElementsAreMovedToNewStorage,
+                              Collection,
+                              GrowingCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection = { 1, 2, 3, 4, 5, 6, 7, 8 };
+  const T item = 9;
+
+  OperationCountingObject::resetCounters();
+  collection.append(item);
+
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+  thenCopiedObjectsCountWas<T>(1);
+  thenMovedObjectsCountWas<T>(8);
+  thenAssignedObjectsCountWas<T>(0);
+  thenDestroyedObjectsCountWas<T>(8);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenDestroyed_ThenOnlyLiveElementsAreDestroyed,
+                              Collection,
+                              GrowingCollections)
+{
+  using T = typename Collection::value_type;
+
+  {
+    Collection collection;
+    collection.append(1);
+    collection.append(2);
+
+    OperationCountingObject::resetCounters();
+  }
+
+  thenDestroyedObjectsCountWas<T>(2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenShiftingElements_ThenOrderIsPreserved,
+                              Collection,
+                              GrowingCollections)
+{
+  Collection collection;
+  for (int i = 0; i < 100; ++i)
+    collection.prepend(i);
+
+  collection.insert(begin(collection) + 50, 1000);
+  collection.erase(begin(collection) + 10, begin(collection) + 20);
+
+  BOOST_CHECK_EQUAL(collection.popFirst(), 99);
+  BOOST_CHECK_EQUAL(collection.popLast(), 0);
+  BOOST_CHECK_EQUAL(collection.getSize(), 89);
+  BOOST_CHECK_EQUAL(*(begin(collection) + 39), 1000);
+  BOOST_CHECK_EQUAL(*(begin(collection) + 40), 49);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenThrowingCopy_WhenCopyAssigningLargerCollection_ThenCollectionIsUnchanged,
+                              Collection,
+                              CopyThrowingCollections)
+{
+  Collection collection = { 1, 2 };
+  const Collection other = { 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+  CopyThrowingObject::armed = true;
+  BOOST_CHECK_THROW(collection = other, std::runtime_error);
+  CopyThrowingObject::armed = false;
+
+  BOOST_REQUIRE_EQUAL(collection.getSize(), 2);
+  BOOST_CHECK_EQUAL(collection[0].value, 1);
+  BOOST_CHECK_EQUAL(collection[1].value, 2);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTypeWithoutDefaultConstructor_WhenUsingCollection_ThenItWorks,
+                              Collection,
+                              NoDefaultCollections)
+{
+  Collection collection;
+  for (int i = 0; i < 20; ++i)
+    collection.append(NoDefault(i));
+  collection.prepend(NoDefault(-1));
+
+  BOOST_CHECK_EQUAL(collection.getSize(), 21);
+  BOOST_CHECK_EQUAL(collection.popFirst().value, -1);
+  BOOST_CHECK_EQUAL(collection.popLast().value, 19);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAddingRvalues_ThenNothingIsCopied,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection = { 1, 2, 3, 4 };
+
+  OperationCountingObject::resetCounters();
+  collection.append(T{5});
+  collection.prepend(T{0});
+  collection.insert(begin(collection) + 2, T{100});
+
+  thenCollectionContainsValues(collection, { 0, 1, 100, 2, 3, 4, 5 });
+  thenCopiedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenEmplacing_ThenItemsAreConstructedInPlace,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection;
+
+  OperationCountingObject::resetCounters();
+  collection.emplaceBack(2);
+  collection.emplaceBack(4);
+
+  thenConstructedObjectsCountWas<T>(2);
+  thenCopiedObjectsCountWas<T>(0);
+  thenMovedObjectsCountWas<T>(0);
+
+  collection.emplaceFront(1);
+
+  thenCollectionContainsValues(collection, { 1, 2, 4 });
+  thenCopiedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenEmplacingInMiddle_ThenNothingIsCopied,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection = { 1, 2, 4 };
+
+  OperationCountingObject::resetCounters();
+  auto &item = collection.emplace(begin(collection) + 2, 3);
+
+  BOOST_CHECK_EQUAL(item, 3);
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+  thenCopiedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenPopping_ThenItemsAreMovedOut,
+                              Collection,
+                              TestedCollections)
+{
+  using T = typename Collection::value_type;
+
+  Collection collection = { 1, 2, 3 };
+
+  OperationCountingObject::resetCounters();
+  T first = collection.popFirst();
+  T last = collection.popLast();
+
+  BOOST_CHECK_EQUAL(first, 1);
+  BOOST_CHECK_EQUAL(last, 3);
+  thenCopiedObjectsCountWas<T>(0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,935 +1,663 @@
 #include "../src/LinkedList.h"
+#include "CountingResource.h"
+#include "OperationCountingObject.h"
 
 #include <initializer_list>
 #include <complex>
 #include <cstdint>
-#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 
-#include <boost/mpl/list.hpp>
-
-namespace
-{
-
-class OperationCountingObject
-{
-public:
-  OperationCountingObject(int value_ = 0)
-    : value(value_)
-  {
-    ++constructedObjects;
-  }
-
-  OperationCountingObject(const OperationCountingObject& other)
-    : value(std::move(other.value))
-  {
-    ++constructedObjects;
-    ++copiedObjects;
-  }
-
-  OperationCountingObject(OperationCountingObject&& other)
-    : value(other.value)
-  {
-    ++constructedObjects;
-    ++movedObjects;
-  }
-
-  ~OperationCountingObject()
-  {
-    ++destroyedObjects;
-  }
-
-  OperationCountingObject& operator=(const OperationCountingObject& other)
-  {
-    ++assignedObjects;
-    value = other.value;
-    return *this;
-  }
-
-  OperationCountingObject& operator=(OperationCountingObject&& other)
-  {
-    ++assignedObjects;
-    ++movedObjects;
-    value = std::move(other.value);
-    return *this;
-  }
-
-  operator int() const
-  {
-    return value;
-  }
-
-  static void resetCounters()
-  {
-    constructedObjects = 0;
-    destroyedObjects = 0;
-    copiedObjects = 0;
-    movedObjects = 0;
-    assignedObjects = 0;
-  }
-
-  static std::size_t constructedObjectsCount()
-  {
-    return constructedObjects;
-  }
-
-  static std::size_t destroyedObjectsCount()
-  {
-    return destroyedObjects;
-  }
-
-  static std::size_t copiedObjectsCount()
-  {
-    return copiedObjects;
-  }
-
-  static std::size_t movedObjectsCount()
-  {
-    return movedObjects;
-  }
-
-  static std::size_t assignedObjectsCount()
-  {
-    return assignedObjects;
-  }
-
-private:
-  int value;
-
-  static std::size_t constructedObjects;
-  static std::size_t destroyedObjects;
-  static std::size_t copiedObjects;
-  static std::size_t movedObjects;
-  static std::size_t assignedObjects;
-};
-
-std::size_t OperationCountingObject::constructedObjects = 0;
-std::size_t OperationCountingObject::destroyedObjects = 0;
-std::size_t OperationCountingObject::copiedObjects = 0;
-std::size_t OperationCountingObject::movedObjects = 0;
-std::size_t OperationCountingObject::assignedObjects = 0 ;
-
-std::ostream& operator<<(std::ostream& out, const OperationCountingObject& obj)
-{
-  return out << '<' << static_cast<int>(obj) << '>';
-}
-
-struct Fixture
-{
-  Fixture()
-  {
-    OperationCountingObject::resetCounters();
-  }
-};
-
-} // namespace
-
 template <typename T>
 using LinearCollection = aisdi::LinkedList<T>;
 
-using TestedTypes = boost::mpl::list<std::int32_t,
-                                     std::uint64_t,
-                                     std::complex<std::int32_t>,
-                                     OperationCountingObject>;
-
 using std::begin;
 using std::end;
 
-BOOST_FIXTURE_TEST_SUITE(VectorTests, Fixture)
+BOOST_FIXTURE_TEST_SUITE(LinkedListTests, Fixture)
 
-template <typename T>
-void thenCollectionContainsValues(const LinearCollection<T>& collection,
-                                  std::initializer_list<int> expected)
+BOOST_AUTO_TEST_CASE(GivenMemoryResource_WhenAddingItems_ThenNodesComeFromIt)
 {
-  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
-                                begin(expected), end(expected));
+  CountingResource resource;
+  {
+    aisdi::pmr::LinkedList<int> collection(&resource);
+    for (int i = 0; i < 20; ++i)
+      collection.append(i);
+    collection.popFirst();
+
+    // the guard, the node pool and its two slabs, a block of 18 nodes each
+    BOOST_CHECK_EQUAL(resource.allocations, 4);
+    BOOST_CHECK(collection.getAllocator().resource() == &resource);
+  }
+  BOOST_CHECK_EQUAL(resource.bytesInUse, 0);
 }
 
-template <typename T>
-void thenConstructedObjectsCountWas(std::size_t count)
+BOOST_AUTO_TEST_CASE(GivenRange_WhenConstructing_ThenNodesComeFromOneSlabInListOrder)
 {
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
-
-template <typename T>
-void thenDestroyedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
+  CountingResource resource;
+  std::vector<int> values(1000);
+  for (int i = 0; i < 1000; ++i)
+    values[i] = i;
+  {
+    aisdi::pmr::LinkedList<int> collection(values.begin(), values.end(), &resource);
 
-template <typename T>
-void thenCopiedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
+    // the guard, the node pool and a single slab
+    BOOST_CHECK_EQUAL(resource.allocations, 3);
+    BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), values.begin(), values.end());
 
-template <typename T>
-void thenMovedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
+    // one after another, only the header of every block lies in between
+    for (auto it = begin(collection) + 1; it != end(collection); ++it)
+      BOOST_CHECK(&*(it - 1) < &*it);
 
-template <typename T>
-void thenAssignedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
-
-template <>
-void thenConstructedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(), count);
-}
-
-template <>
-void thenDestroyedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::destroyedObjectsCount(), count);
+    aisdi::pmr::LinkedList<int> copy(collection, &resource);
+    BOOST_CHECK_EQUAL(resource.allocations, 6);
+  }
+  BOOST_CHECK_EQUAL(resource.bytesInUse, 0);
 }
 
-template <>
-void thenCopiedObjectsCountWas<OperationCountingObject>(std::size_t count)
+BOOST_AUTO_TEST_CASE(GivenInputIterators_WhenConstructing_ThenAllItemsAreInCollection)
 {
-  BOOST_CHECK_EQUAL(OperationCountingObject::copiedObjectsCount(), count);
-}
+  std::istringstream stream("4 8 15 16 23 42");
 
-template <>
-void thenMovedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::movedObjectsCount(), count);
-}
+  aisdi::LinkedList<int> collection(std::istream_iterator<int>(stream), std::istream_iterator<int>{});
 
-template <>
-void thenAssignedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::assignedObjectsCount(), count);
+  const std::initializer_list<int> expected = { 4, 8, 15, 16, 23, 42 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  BOOST_CHECK_EQUAL(collection.getSize(), 6);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenReservedCollection_WhenDestroyed_ThenEveryItemIsDestroyed,
                               T,
                               TestedTypes)
 {
-  const LinearCollection<T> collection;
+  {
+    LinearCollection<T> collection;
+    collection.reserve(100);
+    for (int i = 0; i < 100; ++i)
+      collection.append(i);
+    OperationCountingObject::resetCounters();
+  }
 
-  BOOST_CHECK(collection.isEmpty());
+  // the guard node holds a default constructed item too
+  thenDestroyedObjectsCountWas<T>(101);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAddingItem_ThenItIsNoLongerEmpty,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenItemsAreRemovedAndAdded_ThenNodesAreReused)
 {
-  LinearCollection<T> collection;
+  CountingResource resource;
+  aisdi::pmr::LinkedList<int> collection(&resource);
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
+  const auto allocations = resource.allocations;
 
-  collection.append(T{});
+  for (int i = 0; i < 50; ++i)
+    collection.popFirst();
+  collection.erase(begin(collection), begin(collection) + 10);
+  for (int i = 0; i < 60; ++i)
+    collection.prepend(i);
 
-  BOOST_CHECK(!collection.isEmpty());
+  BOOST_CHECK_EQUAL(resource.allocations, allocations);
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenGettingIterators_ThenBeginEqualsEnd,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReleasingAsynchronously_ThenItemsAreDestroyedInBackground,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection;
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+  OperationCountingObject::resetCounters();
 
+  collection.releaseAsync();
+  BOOST_CHECK(collection.isEmpty());
   BOOST_CHECK(begin(collection) == end(collection));
-  BOOST_CHECK(const_cast<const LinearCollection<T>&>(collection).begin() == collection.end());
-  BOOST_CHECK(collection.cbegin() == collection.cend());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenGettingIterator_ThenBeginIsNotEnd,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(T{});
+  aisdi::BackgroundReclaimer::instance().drain();
 
-  BOOST_CHECK(collection.begin() != collection.end());
+  // the old guard node holds a default constructed item too
+  thenDestroyedObjectsCountWas<T>(5);
+  collection.append(T{7});
+  thenCollectionContainsValues(collection, { 7 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithOneElement_WhenIterating_ThenElementIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(753);
-
-  auto it = collection.begin();
-
-  BOOST_CHECK_EQUAL(*it, 753);
-  BOOST_CHECK(++it == collection.end());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostIncrementing_ThenPreviousPositionIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(T{});
-
-  auto it = collection.begin();
-  auto postIncrementedIt = it++;
-
-  BOOST_CHECK(postIncrementedIt == collection.begin());
-  BOOST_CHECK(it == collection.end());
-  BOOST_CHECK(postIncrementedIt == collection.cbegin());
-  BOOST_CHECK(it == collection.cend());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreIncrementing_ThenNewPositionIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(T{});
-
-  auto it = collection.begin();
-  auto preIncrementedIt = ++it;
-
-  BOOST_CHECK(preIncrementedIt == it);
-  BOOST_CHECK(it == collection.end());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenIncrementing_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(collection.end()++, std::out_of_range);
-  BOOST_CHECK_THROW(++(collection.end()), std::out_of_range);
-  BOOST_CHECK_THROW(collection.cend()++, std::out_of_range);
-  BOOST_CHECK_THROW(++(collection.cend()), std::out_of_range);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDecrementing_ThenIteratorPointsToLastItem,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(1);
-  collection.append(2);
-
-  auto it = collection.end();
-  --it;
-
-  BOOST_CHECK_EQUAL(*it, 2);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreDecrementing_ThenNewIteratorValueIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(1);
-
-  auto it = collection.end();
-  auto preDecremented = --it;
-
-  BOOST_CHECK(it == preDecremented);
-  BOOST_CHECK_EQUAL(*it, 1);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostDecrementing_ThenOldIteratorValueIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(1);
-
-  auto it = collection.end();
-  auto postDecremented = it--;
-
-  BOOST_CHECK(postDecremented == collection.end());
-  BOOST_CHECK_EQUAL(*it, 1);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBeginIterator_WhenDecrementing_ThenOperationThrows,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenReleasingAsynchronously_ThenAllMemoryIsReturned)
 {
-  LinearCollection<T> collection;
+  CountingResource resource;
+  aisdi::pmr::LinkedList<int> collection(&resource);
+  const auto emptyListBytes = resource.bytesInUse;
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
 
-  BOOST_CHECK_THROW(collection.begin()--, std::out_of_range);
-  BOOST_CHECK_THROW(--(collection.begin()), std::out_of_range);
-  BOOST_CHECK_THROW(collection.cbegin()--, std::out_of_range);
-  BOOST_CHECK_THROW(--(collection.cbegin()), std::out_of_range);
-}
+  collection.releaseAsync();
+  aisdi::BackgroundReclaimer::instance().drain();
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDereferencing_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
-  BOOST_CHECK_THROW(*collection.cend(), std::out_of_range);
+  BOOST_CHECK_EQUAL(resource.bytesInUse, emptyListBytes);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenConstIterator_WhenDereferencing_ThenItemIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenSplicedCollections_WhenReleasingAsynchronously_ThenOtherCollectionIsUntouched)
 {
-  LinearCollection<T> collection = { 10, 20, 30 };
+  aisdi::LinkedList<int> collection = { 1, 2 };
+  aisdi::LinkedList<int> other = { 3, 4 };
+  collection.concat(other);
+  other.append(5);
+  auto tail = collection.splitAt(begin(collection) + 1);
 
-  auto it = ++collection.cbegin();
+  collection.releaseAsync();
+  other.append(6);
+  tail.append(7);
+  aisdi::BackgroundReclaimer::instance().drain();
 
-  BOOST_CHECK_EQUAL(*it, 20);
+  BOOST_CHECK(collection.isEmpty());
+  const std::initializer_list<int> expectedOther = { 5, 6 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(other), end(other), begin(expectedOther), end(expectedOther));
+  const std::initializer_list<int> expectedTail = { 2, 3, 4, 7 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(tail), end(tail), begin(expectedTail), end(expectedTail));
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenDereferencing_ThenItemCanBeChanged,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenClearing_ThenOnlyEmptyListStaysAllocated)
 {
-  LinearCollection<T> collection = { 10, 20, 30 };
-
-  auto it = ++begin(collection);
-  *it = 500;
+  CountingResource resource;
+  aisdi::pmr::LinkedList<int> collection(&resource);
+  const auto emptyListBytes = resource.bytesInUse;
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
 
-  thenCollectionContainsValues(collection, { 10, 500, 30 });
-}
+  collection.clear();
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenAddingInteger_ThenAdvancedIteratorIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 2001, 2010, 2051 };
-
-  auto it = begin(collection);
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(resource.bytesInUse, emptyListBytes);
 
-  BOOST_CHECK(it + 3 == end(collection));
+  collection.append(7);
+  BOOST_CHECK_EQUAL(collection.popLast(), 7);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenSubstractingInteger_ThenChangedIteratorIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenDifferentMemoryResources_WhenMoveAssigning_ThenItemsAreMovedIntoOwnResource)
 {
-  LinearCollection<T> collection = { 2001, 2010, 2051 };
-
-  auto it = end(collection);
-
-  BOOST_CHECK(it - 2 == ++begin(collection));
-}
+  CountingResource first, second;
+  aisdi::pmr::LinkedList<int> collection({ 1, 2, 3 }, &first);
+  aisdi::pmr::LinkedList<int> other({ 7 }, &second);
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAddingItem_ThenItemIsInCollection,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  collection.append(42);
-
-  thenCollectionContainsValues(collection, { 42 });
-}
+  other = std::move(collection);
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenInitializingFromList_ThenAllItemsAreInCollection,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection = { 1410, 753, 1789 };
+  const std::initializer_list<int> expected = { 1, 2, 3 };
+  BOOST_CHECK(other.getAllocator().resource() == &second);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(other), end(other), begin(expected), end(expected));
+  BOOST_CHECK(collection.isEmpty());
+  // the guard, the pool, a slab for { 7 } and a fresh one for the moved items
+  BOOST_CHECK_EQUAL(second.allocations, 4);
 
-  thenCollectionContainsValues(collection, { 1410, 753, 1789 });
+  aisdi::pmr::LinkedList<int> copy(other, &first);
+  BOOST_CHECK(copy.getAllocator().resource() == &first);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(copy), end(copy), begin(expected), end(expected));
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenCreatingCopy_ThenAllItemsAreCopied,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoCollections_WhenSplicing_ThenNodesAreMovedWithoutCopies,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 1410, 753, 1789 };
-  LinearCollection<T> other{collection};
-
-  collection.append(1024);
-
-  thenCollectionContainsValues(collection, { 1410, 753, 1789, 1024 });
-  thenCollectionContainsValues(other, { 1410, 753, 1789 });
-}
+  LinearCollection<T> collection = { 1, 5 };
+  LinearCollection<T> other = { 2, 3, 4 };
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenCreatingCopy_ThenBothCollectionsAreEmpty,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  LinearCollection<T> other{collection};
+  OperationCountingObject::resetCounters();
+  collection.splice(begin(collection) + 1, other);
 
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 5);
   BOOST_CHECK(other.isEmpty());
-  BOOST_CHECK(collection.isEmpty());
+  thenConstructedObjectsCountWas<T>(0);
+  thenDestroyedObjectsCountWas<T>(0);
+
+  other.append(6);
+  thenCollectionContainsValues(other, { 6 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMovingToOther_ThenAllItemsAreMoved,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoCollections_WhenSplicingRange_ThenOnlyRangeIsMoved,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 1410, 753, 1789 };
+  LinearCollection<T> collection = { 1, 2 };
+  LinearCollection<T> other = { 10, 20, 30, 40 };
+  const T *moved = &*(begin(other) + 1);
 
   OperationCountingObject::resetCounters();
-  LinearCollection<T> other{std::move(collection)};
+  collection.splice(end(collection), other, begin(other) + 1, end(other) - 1);
 
-  thenCollectionContainsValues(other, { 1410, 753, 1789 });
+  thenCollectionContainsValues(collection, { 1, 2, 20, 30 });
+  thenCollectionContainsValues(other, { 10, 40 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 4);
+  BOOST_CHECK_EQUAL(other.getSize(), 2);
+  BOOST_CHECK_EQUAL(&*(begin(collection) + 2), moved);
   thenConstructedObjectsCountWas<T>(0);
-  thenCopiedObjectsCountWas<T>(0);
-  thenAssignedObjectsCountWas<T>(0);
   thenMovedObjectsCountWas<T>(0);
   thenDestroyedObjectsCountWas<T>(0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMovingToOther_ThenSecondCollectionsIsEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSplicingRangeWithinIt_ThenItemsAreReordered,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection;
-  LinearCollection<T> other{std::move(collection)};
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5 };
 
-  BOOST_CHECK(other.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenAssigningToOther_ThenAllElementsAreCopied,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection = { 1, 2, 3, 4 };
-  LinearCollection<T> other = { 100, 200, 300, 400 };
-
-  other = collection;
+  collection.splice(begin(collection), collection, begin(collection) + 3, end(collection));
 
-  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
-  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+  thenCollectionContainsValues(collection, { 4, 5, 1, 2, 3 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 5);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAssigningToOther_ThenOtherCollectionIsEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSplitting_ThenTailIsMovedToNewCollection,
                               T,
                               TestedTypes)
 {
-  const LinearCollection<T> collection;
-  LinearCollection<T> other = { 100, 200, 300, 400 };
-
-  other = collection;
-
-  BOOST_CHECK(other.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  collection = collection;
-
-  BOOST_CHECK(collection.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 100, 200, 300, 400 };
-
-  collection = collection;
-
-  thenCollectionContainsValues(collection, { 100, 200, 300, 400 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMoveAssigning_ThenAllElementsAreMoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 1, 2, 3, 4 };
-  LinearCollection<T> other = { 100, 200, 300, 400 };
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6 };
+  const T *moved = &*(begin(collection) + 4);
 
   OperationCountingObject::resetCounters();
-  other = std::move(collection);
-
-  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
-  thenConstructedObjectsCountWas<T>(0);
+  auto tail = collection.splitAt(begin(collection) + 4);
+  auto longTail = collection.splitAt(begin(collection) + 1);
+  auto empty = collection.splitAt(end(collection));
+  // only the guards of the new lists hold new items
+  thenConstructedObjectsCountWas<T>(3);
   thenCopiedObjectsCountWas<T>(0);
-  thenAssignedObjectsCountWas<T>(0);
   thenMovedObjectsCountWas<T>(0);
-  thenDestroyedObjectsCountWas<T>(4);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMoveAssigning_ThenNewCollectionIsEmpty,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  LinearCollection<T> other = { 100, 200, 300, 400 };
-
-  other = std::move(collection);
-
-  BOOST_CHECK(other.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppendingItem_ThenItemIsLast,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 1, 2, 3 };
-
-  collection.append(42);
-
-  thenCollectionContainsValues(collection, { 1, 2, 3, 42 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPrependingItem_ThenItemIsAdded,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  collection.prepend(300);
+  thenDestroyedObjectsCountWas<T>(0);
 
-  thenCollectionContainsValues(collection, { 300 });
+  thenCollectionContainsValues(collection, { 1 });
+  thenCollectionContainsValues(longTail, { 2, 3, 4 });
+  thenCollectionContainsValues(tail, { 5, 6 });
+  BOOST_CHECK_EQUAL(&*begin(tail), moved);
+  BOOST_CHECK_EQUAL(tail.getSize(), 2);
+  BOOST_CHECK_EQUAL(longTail.getSize(), 3);
+  BOOST_CHECK(empty.isEmpty());
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPrependingItem_ThenItemIsFirst,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoCollections_WhenConcatenating_ThenOtherIsAppended,
                               T,
                               TestedTypes)
 {
   LinearCollection<T> collection = { 1, 2 };
+  LinearCollection<T> other = { 3, 4 };
 
-  collection.prepend(300);
+  collection.concat(other);
+  collection.concat(other);
 
-  thenCollectionContainsValues(collection, { 300, 1, 2 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenGettingSize_ThenZeroIsReturned,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection;
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 0);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenGettingSize_ThenElementCountIsReturned,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection = { 12, 100, 500 };
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 3);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenChangingIt_ThenItsSizeAlsoChanges,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 72, 27, 77 };
-  collection.append(99);
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 4);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPrependingItem_ThenSizeIsUpdated,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 72, 27, 77 };
-  collection.prepend(99);
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 4);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenInsertingItem_ThenItemIsAdded,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  collection.insert(begin(collection), 42);
-
-  thenCollectionContainsValues(collection, { 42 });
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
+  BOOST_CHECK(other.isEmpty());
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAtBegin_ThenItemIsPrepended,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenSplicedCollections_WhenDestroyedInAnyOrder_ThenAllMemoryIsReturned)
 {
-  LinearCollection<T> collection = { 11, 12, 13 };
-
-  collection.insert(begin(collection), 42);
-
-  thenCollectionContainsValues(collection, { 42, 11, 12, 13 });
+  CountingResource resource;
+  {
+    aisdi::pmr::LinkedList<int> collection({ 1, 2, 3 }, &resource);
+    {
+      aisdi::pmr::LinkedList<int> other({ 4, 5, 6 }, &resource);
+      aisdi::pmr::LinkedList<int> third({ 7, 8 }, &resource);
+      collection.splice(end(collection), other, begin(other), begin(other) + 2);
+      third.concat(other);
+      other.concat(collection);
+      collection.append(9);
+    }
+    const std::initializer_list<int> expected = { 9 };
+    BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  }
+  BOOST_CHECK_EQUAL(resource.bytesInUse, 0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAtEnd_ThenItemIsAppended,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenDifferentMemoryResources_WhenSplicing_ThenItemsAreMovedIntoOwnResource)
 {
-  LinearCollection<T> collection = { 11, 12, 13 };
+  CountingResource first, second;
+  aisdi::pmr::LinkedList<int> collection({ 1 }, &first);
+  aisdi::pmr::LinkedList<int> other({ 2, 3 }, &second);
+  const auto secondBytes = second.bytesInUse;
 
-  collection.insert(end(collection), 42);
+  collection.splice(end(collection), other);
 
-  thenCollectionContainsValues(collection, { 11, 12, 13, 42 });
+  const std::initializer_list<int> expected = { 1, 2, 3 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  BOOST_CHECK(other.isEmpty());
+  BOOST_CHECK(second.bytesInUse < secondBytes);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingInMiddle_ThenItemInserted,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenSplitCollection_WhenHeadIsDestroyed_ThenOnlySlabsOfTailAreKept)
 {
-  LinearCollection<T> collection = { 11, 12, 13 };
-
-  collection.insert(++begin(collection), 42);
-
-  thenCollectionContainsValues(collection, { 11, 42, 12, 13 });
+  CountingResource resource;
+  {
+    auto collection = std::make_unique<aisdi::pmr::LinkedList<int>>(&resource);
+    for (int i = 0; i < 1000; ++i)
+      collection->append(i);
+    const auto allocations = resource.allocations;
+    const auto bytes = resource.bytesInUse;
+
+    auto tail = collection->splitAt(begin(*collection) + 992);
+    // a guard and a pool, the nodes stay where they are
+    BOOST_CHECK_EQUAL(resource.allocations, allocations + 2);
+
+    collection.reset();
+    BOOST_CHECK(resource.bytesInUse < bytes / 2);
+    tail.append(1000);
+    BOOST_CHECK_EQUAL(tail.getSize(), 9);
+    BOOST_CHECK_EQUAL(*begin(tail), 992);
+    BOOST_CHECK_EQUAL(*(end(tail) - 1), 1000);
+  }
+  BOOST_CHECK_EQUAL(resource.bytesInUse, 0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInserting_ThenSizeIsUpdated,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSplittingInsideSlab_ThenTailOutlivesHead,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 101, 102, 103 };
+  auto collection = std::make_unique<LinearCollection<T>>(std::initializer_list<T>{ 1, 2, 3, 4, 5, 6 });
 
-  collection.insert(begin(collection), 27);
+  auto tail = collection->splitAt(begin(*collection) + 3);
+  collection->append(T{7});
+  thenCollectionContainsValues(*collection, { 1, 2, 3, 7 });
+  collection.reset();
+  tail.append(T{8});
 
-  BOOST_CHECK_EQUAL(collection.getSize(), 4);
+  thenCollectionContainsValues(tail, { 4, 5, 6, 8 });
+  BOOST_CHECK_EQUAL(tail.getSize(), 4);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingFirst_ThenOperationThrows,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenSplitCollections_WhenUsedFromTwoThreads_ThenEachKeepsItsItems)
 {
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
-}
+  aisdi::LinkedList<int> collection;
+  for (int i = 0; i < 10000; ++i)
+    collection.append(i);
+  auto tail = collection.splitAt(begin(collection) + 5004);
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingLast_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
+  auto churn = [](aisdi::LinkedList<int>& list) {
+    for (int i = 0; i < 100000; ++i)
+    {
+      list.append(list.popFirst());
+      list.erase(begin(list) + 1);
+      list.insert(begin(list) + 1, i);
+    }
+  };
+  std::thread worker([&] { churn(tail); });
+  churn(collection);
+  worker.join();
 
-  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+  BOOST_CHECK_EQUAL(collection.getSize(), 5004);
+  BOOST_CHECK_EQUAL(tail.getSize(), 4996);
+  BOOST_CHECK_EQUAL(collection.count([](int value) { return value < 0; }), 0);
+  BOOST_CHECK_EQUAL(tail.count([](int value) { return value < 0; }), 0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenPoppingFirst_ThenCollectionIsEmpty,
-                              T,
-                              TestedTypes)
+// orders every tested type, complex numbers by their real part
+template <typename T>
+long long sortKey(const T& value)
 {
-  LinearCollection<T> collection = { 420 };
-
-  collection.popFirst();
-
-  BOOST_CHECK(collection.isEmpty());
+  return static_cast<long long>(value);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenPoppingLast_ThenCollectionIsEmpty,
-                              T,
-                              TestedTypes)
+long long sortKey(const std::complex<std::int32_t>& value)
 {
-  LinearCollection<T> collection = { 420 };
-
-  collection.popLast();
-
-  BOOST_CHECK(collection.isEmpty());
+  return value.real();
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenCollectionSizeIsReduced,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenSorting_ThenItemsAreOrderedWithoutCopies,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 14, 10 };
+  LinearCollection<T> collection = { 5, 3, 9, 1, 7, 2, 8, 4, 6 };
 
-  collection.popFirst();
+  OperationCountingObject::resetCounters();
+  collection.sort([](const T& a, const T& b) { return sortKey(a) < sortKey(b); });
 
-  BOOST_CHECK_EQUAL(collection.getSize(), 1);
+  thenCollectionContainsValues(collection, { 1, 2, 3, 4, 5, 6, 7, 8, 9 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 9);
+  thenConstructedObjectsCountWas<T>(0);
+  thenAssignedObjectsCountWas<T>(0);
+  BOOST_CHECK_EQUAL(*(end(collection) - 1), T{9});
+  BOOST_CHECK_EQUAL(*(end(collection) - 9), T{1});
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenCollectionSizeIsReduced,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenEqualKeys_WhenSorting_ThenTheirOrderIsKept)
 {
-  LinearCollection<T> collection = { 14, 10 };
+  aisdi::LinkedList<std::pair<int, int>> collection;
+  for (int i = 0; i < 100; ++i)
+    collection.append({ (i * 37) % 10, i });
 
-  collection.popLast();
+  collection.sort([](const auto& a, const auto& b) { return a.first < b.first; });
 
-  BOOST_CHECK_EQUAL(collection.getSize(), 1);
+  auto previous = *begin(collection);
+  for (auto it = begin(collection) + 1; it != end(collection); ++it)
+  {
+    const auto& item = *it;
+    BOOST_CHECK(previous.first < item.first || (previous.first == item.first && previous.second < item.second));
+    previous = item;
+  }
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenComparator_WhenSorting_ThenItIsUsed)
 {
-  LinearCollection<T> collection = { 300, 8, 480 };
+  aisdi::LinkedList<int> collection = { 2, 5, 1, 4, 3 };
+  aisdi::LinkedList<int> empty;
 
-  collection.popFirst();
+  collection.sort(std::greater<int>());
+  empty.sort();
 
-  thenCollectionContainsValues(collection, { 8, 480 });
+  const std::initializer_list<int> expected = { 5, 4, 3, 2, 1 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  BOOST_CHECK(empty.isEmpty());
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenItemIsRemoved,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenTwoSortedCollections_WhenMerging_ThenResultIsSorted,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 300, 8, 480 };
+  LinearCollection<T> collection = { 1, 4, 6, 10 };
+  LinearCollection<T> other = { 0, 2, 3, 7, 11, 12 };
 
-  collection.popLast();
+  OperationCountingObject::resetCounters();
+  collection.merge(other, [](const T& a, const T& b) { return sortKey(a) < sortKey(b); });
 
-  thenCollectionContainsValues(collection, { 300, 8 });
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4, 6, 7, 10, 11, 12 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 10);
+  BOOST_CHECK(other.isEmpty());
+  thenConstructedObjectsCountWas<T>(0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenItemsIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenEqualKeys_WhenMerging_ThenOwnItemsComeFirst)
 {
-  LinearCollection<T> collection = { 101, 202, 303 };
+  using Item = std::pair<int, char>;
+  aisdi::LinkedList<Item> collection = { { 1, 'a' }, { 2, 'a' } };
+  aisdi::LinkedList<Item> other = { { 1, 'b' }, { 2, 'b' }, { 3, 'b' } };
 
-  BOOST_CHECK_EQUAL(collection.popFirst(), 101);
-}
+  collection.merge(other, [](const Item& a, const Item& b) { return a.first < b.first; });
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenItemsIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 101, 202, 303 };
-
-  BOOST_CHECK_EQUAL(collection.popLast(), 303);
+  std::string order;
+  for (const auto& item : collection)
+    order += item.second;
+  BOOST_CHECK_EQUAL(order, "ababb");
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenErasing_ThenOperationThrows,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenVisitingEachItem_ThenAllAreVisitedInOrder,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection;
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
 
-  BOOST_CHECK_THROW(collection.erase(collection.begin()), std::out_of_range);
-}
+  collection.forEach([](T& item) { item = T(static_cast<int>(sortKey(item) * 2)); });
+  thenCollectionContainsValues(collection, { 2, 4, 6, 8, 10, 12, 14, 16, 18, 20, 22, 24 });
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingEnd_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 20, 16 };
-
-  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
+  const auto& constCollection = collection;
+  long long sum = 0, withoutPrefetching = 0, farAhead = 0;
+  constCollection.forEach([&sum](const T& item) { sum += sortKey(item); });
+  constCollection.template forEach<0>([&](const T& item) { withoutPrefetching += sortKey(item); });
+  constCollection.template forEach<100>([&](const T& item) { farAhead += sortKey(item); });
+  BOOST_CHECK_EQUAL(sum, 156);
+  BOOST_CHECK_EQUAL(withoutPrefetching, 156);
+  BOOST_CHECK_EQUAL(farAhead, 156);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingBegin_ThenItemIsRemoved,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenFinding_ThenFirstMatchingItemIsReturned,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 22, 41, 31 };
+  LinearCollection<T> collection = { 5, 3, 7, 3, 9 };
+  const auto& constCollection = collection;
 
-  collection.erase(begin(collection));
+  auto found = collection.find(T{3});
+  BOOST_CHECK(found == begin(collection) + 1);
+  BOOST_CHECK(collection.find(T{4}) == end(collection));
+  BOOST_CHECK(constCollection.template find<1>(T{9}) == constCollection.cbegin() + 4);
 
-  thenCollectionContainsValues(collection, { 41, 31 });
+  auto greater = collection.findIf([](const T& item) { return sortKey(item) > 5; });
+  BOOST_CHECK(greater == begin(collection) + 2);
+  *greater = T{1};
+  thenCollectionContainsValues(collection, { 5, 3, 1, 3, 9 });
+  BOOST_CHECK(constCollection.findIf([](const T& item) { return sortKey(item) > 9; }) == constCollection.cend());
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingLastItem_ThemItemIsRemoved,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCounting_ThenMatchingItemsAreCounted,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 22, 45, 33 };
-
-  collection.erase(--end(collection));
+  LinearCollection<T> collection = { 5, 3, 7, 3, 9 };
+  const LinearCollection<T> empty;
 
-  thenCollectionContainsValues(collection, { 22, 45 });
+  BOOST_CHECK_EQUAL(collection.count([](const T& item) { return sortKey(item) == 3; }), 2);
+  BOOST_CHECK_EQUAL(collection.template count<0>([](const T& item) { return sortKey(item) > 4; }), 3);
+  BOOST_CHECK_EQUAL(empty.count([](const T&) { return true; }), 0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingMiddleItem_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 22, 51, 48 };
-
-  collection.erase(++begin(collection));
-
-  thenCollectionContainsValues(collection, { 22, 48 });
-}
+template <typename T>
+using IndexedCollection = aisdi::IndexedLinkedList<T>;
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasing_ThenSizeIsReduced,
-                              T,
-                              TestedTypes)
+// checks every position through operator[] and iterator arithmetic
+void thenPositionsMatch(IndexedCollection<int>& collection, const std::vector<int>& expected)
 {
-  LinearCollection<T> collection = { 1000, 500, 2, 900 };
-
-  collection.erase(begin(collection) + 2);
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  BOOST_REQUIRE_EQUAL(collection.getSize(), expected.size());
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  const auto size = static_cast<int>(expected.size());
+  for (int i = 0; i < size; ++i)
+  {
+    BOOST_CHECK_EQUAL(collection[i], expected[i]);
+    BOOST_CHECK_EQUAL(*(begin(collection) + i), expected[i]);
+    BOOST_CHECK_EQUAL(*(end(collection) - (size - i)), expected[i]);
+  }
+  BOOST_CHECK(begin(collection) + size == end(collection));
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenErasing_ThenCollectionIsEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIndexedCollection_WhenAccessingByPosition_ThenItemsAreReturned,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 1529 };
+  IndexedCollection<T> collection = { 1, 2, 3, 4, 5 };
 
-  collection.erase(begin(collection));
+  collection.prepend(0);
+  collection.insert(begin(collection) + 3, 7);
+  collection.erase(end(collection) - 2);
 
-  BOOST_CHECK(collection.isEmpty());
+  const std::initializer_list<int> expected = { 0, 1, 2, 7, 3, 5 };
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection), begin(expected), end(expected));
+  BOOST_CHECK_EQUAL(collection[3], T{7});
+  BOOST_CHECK_EQUAL(*(begin(collection) + 5), T{5});
+  BOOST_CHECK_EQUAL(*(end(collection) - 6), T{0});
+  BOOST_CHECK_THROW(collection[6], std::out_of_range);
+  BOOST_CHECK_THROW(begin(collection) + 7, std::out_of_range);
+  BOOST_CHECK_THROW(end(collection) - 7, std::out_of_range);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingEmptyRange_ThenNothingHappens,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenIndexedCollections_WhenSplicingAndSplitting_ThenPositionsAreKept)
 {
-  LinearCollection<T> collection = { 19, 42, 11 };
+  IndexedCollection<int> collection = { 0, 1, 2, 3, 4, 5 };
+  IndexedCollection<int> other = { 10, 11, 12, 13 };
 
-  collection.erase(begin(collection), begin(collection));
+  collection.splice(begin(collection) + 2, other, begin(other) + 1, begin(other) + 3);
+  thenPositionsMatch(collection, { 0, 1, 11, 12, 2, 3, 4, 5 });
+  thenPositionsMatch(other, { 10, 13 });
 
-  thenCollectionContainsValues(collection, { 19, 42, 11 });
-}
+  collection.splice(begin(collection) + 1, collection, begin(collection) + 5, end(collection));
+  thenPositionsMatch(collection, { 0, 3, 4, 5, 1, 11, 12, 2 });
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRangeFromBegin_ThenItemsAreRemoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 19, 42, 11 };
+  auto tail = collection.splitAt(begin(collection) + 5);
+  thenPositionsMatch(collection, { 0, 3, 4, 5, 1 });
+  thenPositionsMatch(tail, { 11, 12, 2 });
 
-  collection.erase(begin(collection), begin(collection) + 2);
+  tail.concat(other);
+  collection.splice(begin(collection), tail);
+  thenPositionsMatch(collection, { 11, 12, 2, 10, 13, 0, 3, 4, 5, 1 });
+  thenPositionsMatch(tail, {});
 
-  thenCollectionContainsValues(collection, { 11 });
+  collection.erase(begin(collection) + 2, begin(collection) + 4);
+  thenPositionsMatch(collection, { 11, 12, 13, 0, 3, 4, 5, 1 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_whenErasingRangeToEnd_ThenItemsAreRemoved,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenLargeIndexedCollection_WhenSplitting_ThenPositionsAreKept)
 {
-  LinearCollection<T> collection = { 20, 1, 45 };
+  IndexedCollection<int> collection;
+  for (int i = 0; i < 1000; ++i)
+    collection.append(i);
 
-  collection.erase(begin(collection) + 1, end(collection));
+  auto tail = collection.splitAt(begin(collection) + 8);
 
-  thenCollectionContainsValues(collection, { 20 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 8);
+  BOOST_CHECK_EQUAL(tail.getSize(), 992);
+  for (int i = 0; i < 992; ++i)
+    BOOST_CHECK_EQUAL(tail[i], i + 8);
+  BOOST_CHECK_EQUAL(collection[7], 7);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingSingleItemRange_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenIndexedCollections_WhenSortingAndMerging_ThenPositionsAreKept)
 {
-  LinearCollection<T> collection = { 2001, 2010, 2051, 3001 };
-
-  collection.erase(begin(collection) + 1, begin(collection) + 2);
+  IndexedCollection<int> collection = { 5, 3, 9, 1, 7 };
+  IndexedCollection<int> other = { 8, 2, 6 };
 
-  thenCollectionContainsValues(collection, { 2001, 2051, 3001 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingWholeRange_ThenCollectinIsEmpty,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 400, 403, 404 };
+  collection.sort();
+  other.sort();
+  thenPositionsMatch(collection, { 1, 3, 5, 7, 9 });
 
-  collection.erase(begin(collection), end(collection));
+  collection.merge(other);
+  thenPositionsMatch(collection, { 1, 2, 3, 5, 6, 7, 8, 9 });
 
-  BOOST_CHECK(collection.isEmpty());
+  collection.popFirst();
+  collection.popLast();
+  thenPositionsMatch(collection, { 2, 3, 5, 6, 7, 8 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeIsUpdated,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenIndexedCollection_WhenMutatingRandomly_ThenItMatchesVector)
 {
-  LinearCollection<T> collection = { 23, 10, 20, 16 };
+  std::mt19937 random(42);
+  IndexedCollection<int> collection;
+  std::vector<int> expected;
 
-  collection.erase(begin(collection) + 1, end(collection) - 1);
+  for (int step = 0; step < 2000; ++step)
+  {
+    const auto size = static_cast<int>(expected.size());
+    const auto position = static_cast<int>(random() % (expected.size() + 1));
+    switch (random() % 4)
+    {
+    case 0:
+    case 1:
+      collection.insert(begin(collection) + position, step);
+      expected.insert(expected.begin() + position, step);
+      break;
+    case 2:
+      if (position < size)
+      {
+        collection.erase(begin(collection) + position);
+        expected.erase(expected.begin() + position);
+      }
+      break;
+    default:
+      if (position < size)
+        BOOST_REQUIRE_EQUAL(collection[position], expected[position]);
+    }
+  }
 
-  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+  thenPositionsMatch(collection, expected);
 }
 
 // ConstIterator is tested via Iterator methods.
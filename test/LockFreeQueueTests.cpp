@@ -0,0 +1,204 @@
+#include "../src/LockFreeQueue.h"
+#include "CountingResource.h"
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+#include <boost/mpl/list.hpp>
+
+namespace
+{
+
+struct ThrowingOnCopy
+{
+  ThrowingOnCopy() = default;
+  ThrowingOnCopy(const ThrowingOnCopy &) { throw std::runtime_error("copy"); }
+};
+
+} // namespace
+
+template <typename T>
+using PmrSpscQueue = aisdi::SpscQueue<T, std::pmr::polymorphic_allocator<T>>;
+
+template <typename T>
+using PmrMpscQueue = aisdi::MpscQueue<T, std::pmr::polymorphic_allocator<T>>;
+
+using TestedQueues = boost::mpl::list<PmrSpscQueue<std::string>, PmrMpscQueue<std::string>>;
+
+BOOST_AUTO_TEST_SUITE(LockFreeQueueTests)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyQueue_WhenPopping_ThenNothingIsReturned,
+                              Queue,
+                              TestedQueues)
+{
+  CountingResource resource;
+  Queue queue(&resource);
+  std::string out = "untouched";
+
+  BOOST_CHECK(queue.isEmpty());
+  BOOST_CHECK(!queue.tryPop(out));
+  BOOST_CHECK_EQUAL(out, "untouched");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenQueue_WhenPushingAndPopping_ThenItemsComeOutInOrder,
+                              Queue,
+                              TestedQueues)
+{
+  CountingResource resource;
+  Queue queue(&resource);
+  const std::string first = "first";
+
+  queue.push(first);
+  queue.push(std::string("second"));
+  queue.emplace(3, 'x');
+
+  std::string out;
+  BOOST_CHECK(!queue.isEmpty());
+  BOOST_CHECK(queue.tryPop(out));
+  BOOST_CHECK_EQUAL(out, "first");
+  BOOST_CHECK(queue.tryPop(out));
+  BOOST_CHECK_EQUAL(out, "second");
+  BOOST_CHECK(queue.tryPop(out));
+  BOOST_CHECK_EQUAL(out, "xxx");
+  BOOST_CHECK(!queue.tryPop(out));
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenQueueOfBoundedLength_WhenReused_ThenNodesAreRecycled,
+                              Queue,
+                              TestedQueues)
+{
+  CountingResource resource;
+  Queue queue(&resource);
+  std::string out;
+
+  auto pushAndPop = [&queue, &out](int round) {
+    queue.push(std::to_string(round));
+    queue.push(std::to_string(round));
+    queue.tryPop(out);
+    queue.tryPop(out);
+  };
+
+  // the multi-producer queue hands consumed nodes over in batches,
+  // it may need one more node until the first batch is published
+  for (int round = 0; round < 4; ++round)
+    pushAndPop(round);
+  const auto allocations = resource.allocations;
+
+  for (int round = 0; round < 100; ++round)
+    pushAndPop(round);
+
+  BOOST_CHECK_EQUAL(resource.allocations, allocations);
+  BOOST_CHECK_EQUAL(out, "99");
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenQueueWithItems_WhenDestroyed_ThenItemsAndNodesAreFreed,
+                              Queue,
+                              TestedQueues)
+{
+  CountingResource resource;
+  auto shared = std::make_shared<int>(7);
+  {
+    using SharedQueue = std::conditional_t<std::is_same_v<Queue, PmrSpscQueue<std::string>>,
+                                           PmrSpscQueue<std::shared_ptr<int>>,
+                                           PmrMpscQueue<std::shared_ptr<int>>>;
+    SharedQueue queue(&resource);
+    for (int i = 0; i < 10; ++i)
+      queue.push(shared);
+    std::shared_ptr<int> out;
+    queue.tryPop(out);
+    out.reset();
+
+    BOOST_CHECK_EQUAL(shared.use_count(), 10);
+  }
+
+  BOOST_CHECK_EQUAL(shared.use_count(), 1);
+  BOOST_CHECK_EQUAL(resource.bytesInUse, 0);
+}
+
+BOOST_AUTO_TEST_CASE(GivenThrowingConstructor_WhenPushing_ThenQueueIsUnchanged)
+{
+  aisdi::SpscQueue<ThrowingOnCopy> spsc;
+  aisdi::MpscQueue<ThrowingOnCopy> mpsc;
+  const ThrowingOnCopy item;
+
+  BOOST_CHECK_THROW(spsc.push(item), std::runtime_error);
+  BOOST_CHECK_THROW(mpsc.push(item), std::runtime_error);
+  BOOST_CHECK(spsc.isEmpty());
+  BOOST_CHECK(mpsc.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenSpscQueue_WhenUsedFromTwoThreads_ThenAllItemsArriveInOrder)
+{
+  constexpr int items = 200'000;
+  aisdi::SpscQueue<int> queue;
+
+  std::thread producer([&queue] {
+    for (int i = 0; i < items; ++i)
+      queue.push(i);
+  });
+
+  int expected = 0, value = 0;
+  bool ordered = true;
+  while (expected < items)
+  {
+    if (!queue.tryPop(value))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ordered = ordered && value == expected;
+    ++expected;
+  }
+  producer.join();
+
+  BOOST_CHECK(ordered);
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_CASE(GivenMpscQueue_WhenUsedByManyProducers_ThenEachProducerOrderIsKept)
+{
+  constexpr int producers = 4;
+  constexpr int itemsPerProducer = 50'000;
+  aisdi::MpscQueue<std::pair<int, int>> queue;
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+    threads.emplace_back([&queue, p] {
+      for (int i = 0; i < itemsPerProducer; ++i)
+        queue.push({ p, i });
+    });
+
+  std::vector<int> nextFrom(producers, 0);
+  std::pair<int, int> item;
+  bool ordered = true;
+  for (int received = 0; received < producers * itemsPerProducer;)
+  {
+    if (!queue.tryPop(item))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ordered = ordered && item.second == nextFrom[item.first];
+    ++nextFrom[item.first];
+    ++received;
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  BOOST_CHECK(ordered);
+  for (int p = 0; p < producers; ++p)
+    BOOST_CHECK_EQUAL(nextFrom[p], itemsPerProducer);
+  BOOST_CHECK(queue.isEmpty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
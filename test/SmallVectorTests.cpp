@@ -0,0 +1,154 @@
+#include "../src/SmallVector.hpp"
+#include "OperationCountingObject.h"
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+// small inline capacity, so that the tests exercise both storages
+template <typename T>
+using LinearCollection = aisdi::SmallVector<T, 2>;
+
+template <typename T>
+using InlineCollection = aisdi::SmallVector<T, 8>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(SmallVectorTests, Fixture)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFewItems_WhenAppending_ThenTheyAreKeptInline,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection;
+  for (int i = 0; i < 8; ++i)
+    collection.append(i);
+
+  BOOST_CHECK(collection.isInline());
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 8);
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4, 5, 6, 7 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullInlineStorage_WhenAppending_ThenItemsSpillToHeap,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+  collection.append(8);
+
+  BOOST_CHECK(!collection.isInline());
+  BOOST_CHECK_GT(collection.getCapacity(), 8);
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSpilledCollection_WhenShrinkingToFit_ThenItemsReturnInline,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+  collection.popLast();
+  collection.popLast();
+
+  collection.shrinkToFit();
+
+  BOOST_CHECK(collection.isInline());
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4, 5, 6 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInlineCollection_WhenMoving_ThenItemsAreRelocated,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection = { 1, 2, 3 };
+
+  OperationCountingObject::resetCounters();
+  InlineCollection<T> other{std::move(collection)};
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK(other.isInline());
+  thenCollectionContainsValues(other, { 1, 2, 3 });
+  thenCopiedObjectsCountWas<T>(0);
+  thenMovedObjectsCountWas<T>(3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInlineCollection_WhenMovingToPlainVector_ThenItemsAreRelocated,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection = { 1, 2, 3 };
+
+  aisdi::Vector<T> other{std::move(collection)};
+
+  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(other.getSize(), 3);
+  BOOST_CHECK_EQUAL(*other.begin(), 1);
+  collection.append(4);
+  thenCollectionContainsValues(collection, { 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSpilledCollection_WhenMoveAssigningToInlineOne_ThenHeapBufferIsStolen,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection = { 0, 1, 2, 3, 4, 5, 6, 7, 8 };
+  InlineCollection<T> other = { 100 };
+
+  OperationCountingObject::resetCounters();
+  other = std::move(collection);
+
+  BOOST_CHECK(!other.isInline());
+  BOOST_CHECK(collection.isInline());
+  thenCollectionContainsValues(other, { 0, 1, 2, 3, 4, 5, 6, 7, 8 });
+  thenMovedObjectsCountWas<T>(0);
+  thenDestroyedObjectsCountWas<T>(1);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCopying_ThenCopyUsesItsOwnStorage,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection = { 1, 2, 3 };
+  InlineCollection<T> other{collection};
+
+  other.append(4);
+  *collection.begin() = 10;
+
+  BOOST_CHECK(other.isInline());
+  thenCollectionContainsValues(collection, { 10, 2, 3 });
+  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenInlineItems_WhenReleasingAsynchronously_ThenTheyAreDestroyedRightAway,
+                              T,
+                              TestedTypes)
+{
+  InlineCollection<T> collection = { 1, 2, 3 };
+
+  OperationCountingObject::resetCounters();
+  collection.releaseAsync();
+
+  BOOST_CHECK(collection.isEmpty());
+  thenDestroyedObjectsCountWas<T>(3);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenItemsOnHeap_WhenReleasingAsynchronously_ThenInlineStorageIsUsedAgain,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+
+  OperationCountingObject::resetCounters();
+  collection.releaseAsync();
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 2);
+  aisdi::BackgroundReclaimer::instance().drain();
+
+  thenDestroyedObjectsCountWas<T>(4);
+  collection.append(T{5});
+  thenCollectionContainsValues(collection, { 5 });
+}
+
+// ConstIterator is tested via Iterator methods.
+// If Iterator methods are to be changed, then new ConstIterator tests are required.
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,109 @@
+#include "../src/UnrolledLinkedList.h"
+#include "OperationCountingObject.h"
+
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+#include <boost/test/test_tools.hpp>
+
+template <typename T>
+using LinearCollection = aisdi::UnrolledLinkedList<T, 4>;
+
+using std::begin;
+using std::end;
+
+BOOST_FIXTURE_TEST_SUITE(UnrolledLinkedListTests, Fixture)
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenFullNodes_WhenInsertingInMiddle_ThenNodesAreSplit,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+  collection.insert(begin(collection) + 1, 10);
+  collection.insert(begin(collection) + 7, 20);
+  collection.insert(begin(collection) + 4, 30);
+
+  thenCollectionContainsValues(collection, { 1, 10, 2, 3, 30, 4, 5, 6, 20, 7, 8 });
+  BOOST_CHECK_EQUAL(collection.getSize(), 11);
+}
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenSparseNodes_WhenErasing_ThenContentIsKept,
+                              T,
+                              TestedTypes)
+{
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12 };
+
+  collection.erase(begin(collection) + 2, begin(collection) + 10);
+  collection.erase(begin(collection) + 1);
+
+  thenCollectionContainsValues(collection, { 1, 11, 12 });
+  BOOST_CHECK_EQUAL(*(end(collection) - 3), T{1});
+}
+
+BOOST_AUTO_TEST_CASE(GivenManyRandomOperations_WhenComparedWithVector_ThenContentsMatch)
+{
+  LinearCollection<int> collection;
+  std::vector<int> expected;
+
+  unsigned seed = 12345;
+  auto next = [&seed](unsigned bound) {
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 16) % bound;
+  };
+
+  for (int i = 0; i < 5000; ++i)
+  {
+    const auto size = static_cast<unsigned>(expected.size());
+    switch (next(6))
+    {
+    case 0:
+      collection.append(i);
+      expected.push_back(i);
+      break;
+    case 1:
+      collection.prepend(i);
+      expected.insert(expected.begin(), i);
+      break;
+    case 2:
+    {
+      auto position = next(size + 1);
+      collection.insert(begin(collection) + position, i);
+      expected.insert(expected.begin() + position, i);
+      break;
+    }
+    case 3:
+      if (size == 0)
+        break;
+      {
+        auto position = next(size);
+        collection.erase(begin(collection) + position);
+        expected.erase(expected.begin() + position);
+      }
+      break;
+    case 4:
+    {
+      auto first = next(size + 1);
+      auto last = first + next(size - first + 1);
+      collection.erase(begin(collection) + first, begin(collection) + last);
+      expected.erase(expected.begin() + first, expected.begin() + last);
+      break;
+    }
+    default:
+      if (size == 0)
+        break;
+      BOOST_REQUIRE_EQUAL(collection.popLast(), expected.back());
+      expected.pop_back();
+    }
+
+    BOOST_REQUIRE_EQUAL(collection.getSize(), expected.size());
+  }
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
+                                begin(expected), end(expected));
+}
+
+// ConstIterator is tested via Iterator methods.
+// If Iterator methods are to be changed, then new ConstIterator tests are required.
+
+BOOST_AUTO_TEST_SUITE_END()
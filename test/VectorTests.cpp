@@ -1,935 +1,360 @@
 #include "../src/Vector.hpp"
+#include "../src/AlignedAllocator.h"
+#include "CountingResource.h"
+#include "OperationCountingObject.h"
 
+#include <algorithm>
 #include <initializer_list>
-#include <complex>
+#include <iterator>
 #include <cstdint>
-#include <cstddef>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/test_tools.hpp>
 
-#include <boost/mpl/list.hpp>
-
-namespace
-{
-
-class OperationCountingObject
-{
-public:
-  OperationCountingObject(int value_ = 0)
-    : value(value_)
-  {
-    ++constructedObjects;
-  }
-
-  OperationCountingObject(const OperationCountingObject& other)
-    : value(std::move(other.value))
-  {
-    ++constructedObjects;
-    ++copiedObjects;
-  }
-
-  OperationCountingObject(OperationCountingObject&& other)
-    : value(other.value)
-  {
-    ++constructedObjects;
-    ++movedObjects;
-  }
-
-  ~OperationCountingObject()
-  {
-    ++destroyedObjects;
-  }
-
-  OperationCountingObject& operator=(const OperationCountingObject& other)
-  {
-    ++assignedObjects;
-    value = other.value;
-    return *this;
-  }
-
-  OperationCountingObject& operator=(OperationCountingObject&& other)
-  {
-    ++assignedObjects;
-    ++movedObjects;
-    value = std::move(other.value);
-    return *this;
-  }
-
-  operator int() const
-  {
-    return value;
-  }
-
-  static void resetCounters()
-  {
-    constructedObjects = 0;
-    destroyedObjects = 0;
-    copiedObjects = 0;
-    movedObjects = 0;
-    assignedObjects = 0;
-  }
-
-  static std::size_t constructedObjectsCount()
-  {
-    return constructedObjects;
-  }
-
-  static std::size_t destroyedObjectsCount()
-  {
-    return destroyedObjects;
-  }
-
-  static std::size_t copiedObjectsCount()
-  {
-    return copiedObjects;
-  }
-
-  static std::size_t movedObjectsCount()
-  {
-    return movedObjects;
-  }
-
-  static std::size_t assignedObjectsCount()
-  {
-    return assignedObjects;
-  }
-
-private:
-  int value;
-
-  static std::size_t constructedObjects;
-  static std::size_t destroyedObjects;
-  static std::size_t copiedObjects;
-  static std::size_t movedObjects;
-  static std::size_t assignedObjects;
-};
-
-std::size_t OperationCountingObject::constructedObjects = 0;
-std::size_t OperationCountingObject::destroyedObjects = 0;
-std::size_t OperationCountingObject::copiedObjects = 0;
-std::size_t OperationCountingObject::movedObjects = 0;
-std::size_t OperationCountingObject::assignedObjects = 0 ;
-
-std::ostream& operator<<(std::ostream& out, const OperationCountingObject& obj)
-{
-  return out << '<' << static_cast<int>(obj) << '>';
-}
-
-struct Fixture
-{
-  Fixture()
-  {
-    OperationCountingObject::resetCounters();
-  }
-};
-
-} // namespace
-
 template <typename T>
 using LinearCollection = aisdi::Vector<T>;
 
-using TestedTypes = boost::mpl::list<std::int32_t,
-                                     std::uint64_t,
-                                     std::complex<std::int32_t>,
-                                     OperationCountingObject>;
-
 using std::begin;
 using std::end;
 
 BOOST_FIXTURE_TEST_SUITE(VectorTests, Fixture)
 
-template <typename T>
-void thenCollectionContainsValues(const LinearCollection<T>& collection,
-                                  std::initializer_list<int> expected)
-{
-  BOOST_CHECK_EQUAL_COLLECTIONS(begin(collection), end(collection),
-                                begin(expected), end(expected));
-}
-
-template <typename T>
-void thenConstructedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
-
-template <typename T>
-void thenDestroyedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
-
-template <typename T>
-void thenCopiedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
-
-template <typename T>
-void thenMovedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
-
-template <typename T>
-void thenAssignedObjectsCountWas(std::size_t count)
-{
-  (void) count;
-  // unable to check it (in a simple way) for all objects, hence template specialization.
-}
-
-template <>
-void thenConstructedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::constructedObjectsCount(), count);
-}
-
-template <>
-void thenDestroyedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::destroyedObjectsCount(), count);
-}
-
-template <>
-void thenCopiedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::copiedObjectsCount(), count);
-}
-
-template <>
-void thenMovedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::movedObjectsCount(), count);
-}
-
-template <>
-void thenAssignedObjectsCountWas<OperationCountingObject>(std::size_t count)
-{
-  BOOST_CHECK_EQUAL(OperationCountingObject::assignedObjectsCount(), count);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenCreatedWithDefaultConstructor_ThenItIsEmpty,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection;
-
-  BOOST_CHECK(collection.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAddingItem_ThenItIsNoLongerEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenReservedCollection_WhenAppendingUpToReservedSize_ThenNothingIsMoved,
                               T,
                               TestedTypes)
 {
   LinearCollection<T> collection;
+  collection.reserve(100);
 
-  collection.append(T{});
-
-  BOOST_CHECK(!collection.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenGettingIterators_ThenBeginEqualsEnd,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK(begin(collection) == end(collection));
-  BOOST_CHECK(const_cast<const LinearCollection<T>&>(collection).begin() == collection.end());
-  BOOST_CHECK(collection.cbegin() == collection.cend());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenGettingIterator_ThenBeginIsNotEnd,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(T{});
-
-  BOOST_CHECK(collection.begin() != collection.end());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithOneElement_WhenIterating_ThenElementIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(753);
-
-  auto it = collection.begin();
+  OperationCountingObject::resetCounters();
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
 
-  BOOST_CHECK_EQUAL(*it, 753);
-  BOOST_CHECK(++it == collection.end());
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 100);
+  BOOST_CHECK_EQUAL(collection.getSize(), 100);
+  // one move per appended temporary, none caused by reallocation
+  thenMovedObjectsCountWas<T>(100);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostIncrementing_ThenPreviousPositionIsReturned,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReservingLessThanCapacity_ThenNothingChanges,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection;
-  collection.append(T{});
+  LinearCollection<T> collection = { 1, 2, 3 };
 
-  auto it = collection.begin();
-  auto postIncrementedIt = it++;
+  collection.reserve(2);
 
-  BOOST_CHECK(postIncrementedIt == collection.begin());
-  BOOST_CHECK(it == collection.end());
-  BOOST_CHECK(postIncrementedIt == collection.cbegin());
-  BOOST_CHECK(it == collection.cend());
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 3);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreIncrementing_ThenNewPositionIsReturned,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSpareCapacity_WhenShrinkingToFit_ThenCapacityEqualsSize,
                               T,
                               TestedTypes)
 {
   LinearCollection<T> collection;
-  collection.append(T{});
+  for (int i = 0; i < 5; ++i)
+    collection.append(i);
 
-  auto it = collection.begin();
-  auto preIncrementedIt = ++it;
+  collection.shrinkToFit();
 
-  BOOST_CHECK(preIncrementedIt == it);
-  BOOST_CHECK(it == collection.end());
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 5);
+  thenCollectionContainsValues(collection, { 0, 1, 2, 3, 4 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenIncrementing_ThenOperationThrows,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenShrinkingToFit_ThenStorageIsReleased,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection;
+  LinearCollection<T> collection = { 1 };
+  collection.popLast();
 
-  BOOST_CHECK_THROW(collection.end()++, std::out_of_range);
-  BOOST_CHECK_THROW(++(collection.end()), std::out_of_range);
-  BOOST_CHECK_THROW(collection.cend()++, std::out_of_range);
-  BOOST_CHECK_THROW(++(collection.cend()), std::out_of_range);
-}
+  collection.shrinkToFit();
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDecrementing_ThenIteratorPointsToLastItem,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  collection.append(1);
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 0);
   collection.append(2);
-
-  auto it = collection.end();
-  --it;
-
-  BOOST_CHECK_EQUAL(*it, 2);
+  thenCollectionContainsValues(collection, { 2 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPreDecrementing_ThenNewIteratorValueIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenCustomGrowthPolicy_WhenAppending_ThenCapacityFollowsPolicy)
 {
-  LinearCollection<T> collection;
-  collection.append(1);
-
-  auto it = collection.end();
-  auto preDecremented = --it;
-
-  BOOST_CHECK(it == preDecremented);
-  BOOST_CHECK_EQUAL(*it, 1);
-}
+  aisdi::Vector<int, aisdi::GrowthPolicy<4, 3, 2>> collection;
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenPostDecrementing_ThenOldIteratorValueIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
   collection.append(1);
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 4);
 
-  auto it = collection.end();
-  auto postDecremented = it--;
-
-  BOOST_CHECK(postDecremented == collection.end());
-  BOOST_CHECK_EQUAL(*it, 1);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenBeginIterator_WhenDecrementing_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(collection.begin()--, std::out_of_range);
-  BOOST_CHECK_THROW(--(collection.begin()), std::out_of_range);
-  BOOST_CHECK_THROW(collection.cbegin()--, std::out_of_range);
-  BOOST_CHECK_THROW(--(collection.cbegin()), std::out_of_range);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEndIterator_WhenDereferencing_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(*collection.end(), std::out_of_range);
-  BOOST_CHECK_THROW(*collection.cend(), std::out_of_range);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenConstIterator_WhenDereferencing_ThenItemIsReturned,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 10, 20, 30 };
-
-  auto it = ++collection.cbegin();
-
-  BOOST_CHECK_EQUAL(*it, 20);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenDereferencing_ThenItemCanBeChanged,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 10, 20, 30 };
-
-  auto it = ++begin(collection);
-  *it = 500;
-
-  thenCollectionContainsValues(collection, { 10, 500, 30 });
+  for (int i = 0; i < 4; ++i)
+    collection.append(i);
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 6);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenAddingInteger_ThenAdvancedIteratorIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenNeverShrinkPolicy_WhenPoppingAllItems_ThenCapacityIsKept)
 {
-  LinearCollection<T> collection = { 2001, 2010, 2051 };
+  aisdi::Vector<int, aisdi::NeverShrinkPolicy> collection;
+  for (int i = 0; i < 1000; ++i)
+    collection.append(i);
+  auto capacity = collection.getCapacity();
 
-  auto it = begin(collection);
+  while (!collection.isEmpty())
+    collection.popFirst();
 
-  BOOST_CHECK(it + 3 == end(collection));
+  BOOST_CHECK_EQUAL(collection.getCapacity(), capacity);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterator_WhenSubstractingInteger_ThenChangedIteratorIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenDefaultPolicy_WhenPoppingAllItems_ThenCapacityShrinksToInitial)
 {
-  LinearCollection<T> collection = { 2001, 2010, 2051 };
+  LinearCollection<int> collection;
+  for (int i = 0; i < 1000; ++i)
+    collection.append(i);
 
-  auto it = end(collection);
+  while (!collection.isEmpty())
+    collection.popLast();
 
-  BOOST_CHECK(it - 2 == ++begin(collection));
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 8);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAddingItem_ThenItemIsInCollection,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenErasingIf_ThenMatchingItemsAreRemovedInOrder,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection;
-
-  collection.append(42);
+  LinearCollection<T> collection = { 1, 2, 3, 4, 5, 6, 7 };
 
-  thenCollectionContainsValues(collection, { 42 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenInitializingFromList_ThenAllItemsAreInCollection,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection = { 1410, 753, 1789 };
+  auto removed = collection.eraseIf([](const T &item) {
+    return item == T{2} || item == T{4} || item == T{6};
+  });
 
-  thenCollectionContainsValues(collection, { 1410, 753, 1789 });
+  BOOST_CHECK_EQUAL(removed, 3);
+  thenCollectionContainsValues(collection, { 1, 3, 5, 7 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenCreatingCopy_ThenAllItemsAreCopied,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenErasingIf_ThenEachKeptItemIsMovedAtMostOnce,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 1410, 753, 1789 };
-  LinearCollection<T> other{collection};
-
-  collection.append(1024);
-
-  thenCollectionContainsValues(collection, { 1410, 753, 1789, 1024 });
-  thenCollectionContainsValues(other, { 1410, 753, 1789 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenCreatingCopy_ThenBothCollectionsAreEmpty,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  LinearCollection<T> other{collection};
-
-  BOOST_CHECK(other.isEmpty());
-  BOOST_CHECK(collection.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMovingToOther_ThenAllItemsAreMoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 1410, 753, 1789 };
+  LinearCollection<T> collection = { 0, 1, 2, 3, 4, 5 };
+  const T one{1};
 
   OperationCountingObject::resetCounters();
-  LinearCollection<T> other{std::move(collection)};
+  collection.eraseIf([&one](const T &item) { return item == one; });
 
-  thenCollectionContainsValues(other, { 1410, 753, 1789 });
-  thenConstructedObjectsCountWas<T>(0);
+  thenCollectionContainsValues(collection, { 0, 2, 3, 4, 5 });
+  thenMovedObjectsCountWas<T>(4);
   thenCopiedObjectsCountWas<T>(0);
-  thenAssignedObjectsCountWas<T>(0);
-  thenMovedObjectsCountWas<T>(0);
-  thenDestroyedObjectsCountWas<T>(0);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMovingToOther_ThenSecondCollectionsIsEmpty,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  LinearCollection<T> other{std::move(collection)};
-
-  BOOST_CHECK(other.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenAssigningToOther_ThenAllElementsAreCopied,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection = { 1, 2, 3, 4 };
-  LinearCollection<T> other = { 100, 200, 300, 400 };
-
-  other = collection;
-
-  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
-  thenCollectionContainsValues(collection, { 1, 2, 3, 4 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenAssigningToOther_ThenOtherCollectionIsEmpty,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection;
-  LinearCollection<T> other = { 100, 200, 300, 400 };
-
-  other = collection;
-
-  BOOST_CHECK(other.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  collection = collection;
-
-  BOOST_CHECK(collection.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNotEmptyCollection_WhenSelfAssigning_ThenNothingHappens,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 100, 200, 300, 400 };
-
-  collection = collection;
-
-  thenCollectionContainsValues(collection, { 100, 200, 300, 400 });
+  thenDestroyedObjectsCountWas<T>(1);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenMoveAssigning_ThenAllElementsAreMoved,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenNothingMatches_ThenEraseIfLeavesItUntouched,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 1, 2, 3, 4 };
-  LinearCollection<T> other = { 100, 200, 300, 400 };
+  LinearCollection<T> collection = { 1, 2, 3 };
 
   OperationCountingObject::resetCounters();
-  other = std::move(collection);
+  auto removed = collection.eraseIf([](const T &) { return false; });
 
-  thenCollectionContainsValues(other, { 1, 2, 3, 4 });
-  thenConstructedObjectsCountWas<T>(0);
-  thenCopiedObjectsCountWas<T>(0);
-  thenAssignedObjectsCountWas<T>(0);
+  BOOST_CHECK_EQUAL(removed, 0);
+  thenCollectionContainsValues(collection, { 1, 2, 3 });
   thenMovedObjectsCountWas<T>(0);
-  thenDestroyedObjectsCountWas<T>(4);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenMoveAssigning_ThenNewCollectionIsEmpty,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-  LinearCollection<T> other = { 100, 200, 300, 400 };
-
-  other = std::move(collection);
-
-  BOOST_CHECK(other.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenAppendingItem_ThenItemIsLast,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 1, 2, 3 };
-
-  collection.append(42);
-
-  thenCollectionContainsValues(collection, { 1, 2, 3, 42 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPrependingItem_ThenItemIsAdded,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  collection.prepend(300);
-
-  thenCollectionContainsValues(collection, { 300 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPrependingItem_ThenItemIsFirst,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 1, 2 };
-
-  collection.prepend(300);
-
-  thenCollectionContainsValues(collection, { 300, 1, 2 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenGettingSize_ThenZeroIsReturned,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection;
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 0);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenGettingSize_ThenElementCountIsReturned,
-                              T,
-                              TestedTypes)
-{
-  const LinearCollection<T> collection = { 12, 100, 500 };
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 3);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenChangingIt_ThenItsSizeAlsoChanges,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 72, 27, 77 };
-  collection.append(99);
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 4);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPrependingItem_ThenSizeIsUpdated,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 72, 27, 77 };
-  collection.prepend(99);
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 4);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenInsertingItem_ThenItemIsAdded,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  collection.insert(begin(collection), 42);
-
-  thenCollectionContainsValues(collection, { 42 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAtBegin_ThenItemIsPrepended,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 11, 12, 13 };
-
-  collection.insert(begin(collection), 42);
-
-  thenCollectionContainsValues(collection, { 42, 11, 12, 13 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingAtEnd_ThenItemIsAppended,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 11, 12, 13 };
-
-  collection.insert(end(collection), 42);
-
-  thenCollectionContainsValues(collection, { 11, 12, 13, 42 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInsertingInMiddle_ThenItemInserted,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 11, 12, 13 };
-
-  collection.insert(++begin(collection), 42);
-
-  thenCollectionContainsValues(collection, { 11, 42, 12, 13 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenInserting_ThenSizeIsUpdated,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 101, 102, 103 };
-
-  collection.insert(begin(collection), 27);
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 4);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingFirst_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(collection.popFirst(), std::logic_error);
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenPoppingLast_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(collection.popLast(), std::logic_error);
+  thenAssignedObjectsCountWas<T>(0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenPoppingFirst_ThenCollectionIsEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenRemovingAllOfValue_ThenEveryOccurrenceIsRemoved,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 420 };
+  LinearCollection<T> collection = { 7, 1, 7, 7, 2, 7 };
 
-  collection.popFirst();
+  auto removed = collection.removeAll(7);
 
-  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(removed, 4);
+  thenCollectionContainsValues(collection, { 1, 2 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenPoppingLast_ThenCollectionIsEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenLargeCollection_WhenErasingMostOfIt_ThenCapacityShrinksLikeSingleErase,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 420 };
+  LinearCollection<T> byRange;
+  LinearCollection<T> byPredicate;
+  LinearCollection<T> oneByOne;
+  for (int i = 0; i < 1000; ++i)
+  {
+    byRange.append(i);
+    byPredicate.append(i);
+    oneByOne.append(i);
+  }
 
-  collection.popLast();
+  byRange.erase(begin(byRange) + 10, end(byRange));
+  int visited = 0;
+  byPredicate.eraseIf([&visited](const T &) { return visited++ >= 10; });
+  for (int i = 0; i < 990; ++i)
+    oneByOne.popLast();
 
-  BOOST_CHECK(collection.isEmpty());
+  BOOST_CHECK_EQUAL(byRange.getSize(), 10);
+  BOOST_CHECK_EQUAL(byRange.getCapacity(), oneByOne.getCapacity());
+  BOOST_CHECK_EQUAL(byPredicate.getCapacity(), oneByOne.getCapacity());
+  BOOST_CHECK_LT(byRange.getCapacity(), 1000);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenCollectionSizeIsReduced,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenIterators_WhenUsingRandomAccess_ThenPositionsAreComputed,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 14, 10 };
-
-  collection.popFirst();
+  LinearCollection<T> collection = { 10, 20, 30, 40, 50 };
 
-  BOOST_CHECK_EQUAL(collection.getSize(), 1);
+  auto it = begin(collection);
+  it += 3;
+
+  BOOST_CHECK_EQUAL(*it, 40);
+  BOOST_CHECK_EQUAL(it[1], 50);
+  BOOST_CHECK_EQUAL(end(collection) - it, 2);
+  BOOST_CHECK(begin(collection) < it);
+  BOOST_CHECK(it <= it);
+  it -= 2;
+  BOOST_CHECK_EQUAL(*it, 20);
+  BOOST_CHECK_THROW(it += 5, std::out_of_range);
+  BOOST_CHECK_THROW(it -= 2, std::out_of_range);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenCollectionSizeIsReduced,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenIterators_WhenAskingForCategory_ThenTheyAreRandomAccess)
 {
-  LinearCollection<T> collection = { 14, 10 };
+  using Traits = std::iterator_traits<LinearCollection<int>::iterator>;
+  using ConstTraits = std::iterator_traits<LinearCollection<int>::const_iterator>;
 
-  collection.popLast();
-
-  BOOST_CHECK_EQUAL(collection.getSize(), 1);
+  BOOST_CHECK((std::is_same<Traits::iterator_category, std::random_access_iterator_tag>::value));
+  BOOST_CHECK((std::is_same<ConstTraits::iterator_category, std::random_access_iterator_tag>::value));
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenSortingWithStdSort_ThenItemsAreOrdered)
 {
-  LinearCollection<T> collection = { 300, 8, 480 };
+  LinearCollection<int> collection = { 5, 3, 9, 1, 7, 2 };
 
-  collection.popFirst();
+  std::sort(begin(collection), end(collection));
 
-  thenCollectionContainsValues(collection, { 8, 480 });
+  thenCollectionContainsValues(collection, { 1, 2, 3, 5, 7, 9 });
+  BOOST_CHECK(std::binary_search(collection.cbegin(), collection.cend(), 7));
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenCollection_WhenIndexingOutOfRange_ThenOperationThrows)
 {
-  LinearCollection<T> collection = { 300, 8, 480 };
+  LinearCollection<int> collection = { 1, 2 };
+  const auto &constCollection = collection;
 
-  collection.popLast();
-
-  thenCollectionContainsValues(collection, { 300, 8 });
+  BOOST_CHECK_EQUAL(constCollection[1], 2);
+  BOOST_CHECK_THROW(collection[2], std::out_of_range);
+  BOOST_CHECK_THROW(constCollection[2], std::out_of_range);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingFirst_ThenItemsIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenMemoryResource_WhenAddingItems_ThenMemoryComesFromIt)
 {
-  LinearCollection<T> collection = { 101, 202, 303 };
+  CountingResource resource;
+  {
+    aisdi::pmr::Vector<int> collection(&resource);
+    for (int i = 0; i < 100; ++i)
+      collection.append(i);
 
-  BOOST_CHECK_EQUAL(collection.popFirst(), 101);
+    BOOST_CHECK(resource.allocations > 0);
+    BOOST_CHECK(resource.bytesInUse >= 100 * sizeof(int));
+    BOOST_CHECK(collection.getAllocator().resource() == &resource);
+  }
+  BOOST_CHECK_EQUAL(resource.bytesInUse, 0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenPoppingLast_ThenItemsIsReturned,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenMemoryResource_WhenCopying_ThenCopyUsesResourceItWasGiven)
 {
-  LinearCollection<T> collection = { 101, 202, 303 };
+  CountingResource first, second;
+  aisdi::pmr::Vector<int> collection({ 1, 2, 3 }, &first);
 
-  BOOST_CHECK_EQUAL(collection.popLast(), 303);
-}
+  aisdi::pmr::Vector<int> copy(collection, &second);
+  aisdi::pmr::Vector<int> defaultCopy(collection);
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenEmptyCollection_WhenErasing_ThenOperationThrows,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection;
-
-  BOOST_CHECK_THROW(collection.erase(collection.begin()), std::out_of_range);
+  BOOST_CHECK(copy.getAllocator().resource() == &second);
+  BOOST_CHECK(defaultCopy.getAllocator().resource() == std::pmr::get_default_resource());
+  BOOST_CHECK_EQUAL(second.allocations, 1);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(copy), end(copy), begin(collection), end(collection));
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingEnd_ThenOperationThrows,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenDifferentMemoryResources_WhenMoving_ThenBufferIsTakenOnlyFromEqualOne)
 {
-  LinearCollection<T> collection = { 20, 16 };
-
-  BOOST_CHECK_THROW(collection.erase(end(collection)), std::out_of_range);
-}
+  CountingResource first, second;
+  aisdi::pmr::Vector<int> collection({ 1, 2, 3 }, &first);
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingBegin_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 22, 41, 31 };
+  aisdi::pmr::Vector<int> moved(std::move(collection));
+  BOOST_CHECK(moved.getAllocator().resource() == &first);
+  BOOST_CHECK_EQUAL(first.allocations, 1);
 
-  collection.erase(begin(collection));
+  aisdi::pmr::Vector<int> other(&second);
+  other = std::move(moved);
 
-  thenCollectionContainsValues(collection, { 41, 31 });
+  const std::initializer_list<int> expected = { 1, 2, 3 };
+  BOOST_CHECK(other.getAllocator().resource() == &second);
+  BOOST_CHECK_EQUAL_COLLECTIONS(begin(other), end(other), begin(expected), end(expected));
+  BOOST_CHECK(moved.isEmpty());
+  BOOST_CHECK_EQUAL(first.bytesInUse, 0);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingLastItem_ThemItemIsRemoved,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenAlignedCollection_WhenGrowing_ThenBufferStaysAligned,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 22, 45, 33 };
+  aisdi::AlignedVector<T, 64> collection;
 
-  collection.erase(--end(collection));
+  for (int i = 0; i < 100; ++i)
+  {
+    collection.append(i);
+    BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&collection[0]) % 64, 0);
+  }
+  collection.prepend(100);
 
-  thenCollectionContainsValues(collection, { 22, 45 });
+  BOOST_CHECK_EQUAL(collection[0], T{100});
+  BOOST_CHECK_EQUAL(collection[100], T{99});
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingMiddleItem_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenHugePageCollection_WhenBufferExceedsHugePage_ThenItIsAlignedToIt)
 {
-  LinearCollection<T> collection = { 22, 51, 48 };
-
-  collection.erase(++begin(collection));
-
-  thenCollectionContainsValues(collection, { 22, 48 });
-}
+  using Allocator = aisdi::AlignedAllocator<int, 64, true>;
+  aisdi::HugePageVector<int> collection;
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasing_ThenSizeIsReduced,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 1000, 500, 2, 900 };
+  collection.reserve(Allocator::hugePageSize / sizeof(int));
+  for (int i = 0; i < 1000; ++i)
+    collection.append(i);
 
-  collection.erase(begin(collection) + 2);
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&collection[0]) % Allocator::hugePageSize, 0);
+  BOOST_CHECK_EQUAL(collection[999], 999);
 
-  BOOST_CHECK_EQUAL(collection.getSize(), 3);
+  collection.shrinkToFit();
+  BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&collection[0]) % 64, 0);
+  BOOST_CHECK_EQUAL(collection[999], 999);
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollectionWithSingleItem_WhenErasing_ThenCollectionIsEmpty,
+BOOST_AUTO_TEST_CASE_TEMPLATE(GivenCollection_WhenReleasingAsynchronously_ThenItemsAreDestroyedInBackground,
                               T,
                               TestedTypes)
 {
-  LinearCollection<T> collection = { 1529 };
-
-  collection.erase(begin(collection));
+  LinearCollection<T> collection = { 1, 2, 3, 4 };
+  OperationCountingObject::resetCounters();
 
+  collection.releaseAsync();
   BOOST_CHECK(collection.isEmpty());
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingEmptyRange_ThenNothingHappens,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 19, 42, 11 };
-
-  collection.erase(begin(collection), begin(collection));
-
-  thenCollectionContainsValues(collection, { 19, 42, 11 });
-}
+  BOOST_CHECK_EQUAL(collection.getCapacity(), 0);
+  aisdi::BackgroundReclaimer::instance().drain();
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRangeFromBegin_ThenItemsAreRemoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 19, 42, 11 };
-
-  collection.erase(begin(collection), begin(collection) + 2);
-
-  thenCollectionContainsValues(collection, { 11 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_whenErasingRangeToEnd_ThenItemsAreRemoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 20, 1, 45 };
-
-  collection.erase(begin(collection) + 1, end(collection));
-
-  thenCollectionContainsValues(collection, { 20 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingSingleItemRange_ThenItemIsRemoved,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 2001, 2010, 2051, 3001 };
-
-  collection.erase(begin(collection) + 1, begin(collection) + 2);
-
-  thenCollectionContainsValues(collection, { 2001, 2051, 3001 });
-}
-
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingWholeRange_ThenCollectinIsEmpty,
-                              T,
-                              TestedTypes)
-{
-  LinearCollection<T> collection = { 400, 403, 404 };
-
-  collection.erase(begin(collection), end(collection));
-
-  BOOST_CHECK(collection.isEmpty());
+  thenDestroyedObjectsCountWas<T>(4);
+  collection.append(T{7});
+  thenCollectionContainsValues(collection, { 7 });
 }
 
-BOOST_AUTO_TEST_CASE_TEMPLATE(GivenNonEmptyCollection_WhenErasingRange_ThenSizeIsUpdated,
-                              T,
-                              TestedTypes)
+BOOST_AUTO_TEST_CASE(GivenMemoryResource_WhenReleasingAsynchronously_ThenBufferIsReturned)
 {
-  LinearCollection<T> collection = { 23, 10, 20, 16 };
+  CountingResource resource;
+  aisdi::pmr::Vector<int> collection(&resource);
+  for (int i = 0; i < 100; ++i)
+    collection.append(i);
 
-  collection.erase(begin(collection) + 1, end(collection) - 1);
+  collection.releaseAsync();
+  aisdi::BackgroundReclaimer::instance().drain();
 
-  BOOST_CHECK_EQUAL(collection.getSize(), 2);
+  BOOST_CHECK_EQUAL(resource.bytesInUse, 0);
 }
 
 // ConstIterator is tested via Iterator methods.